@@ -145,21 +145,6 @@ namespace tinystl {
 		buffer_bmove_urange_traits(dest, first, last, pod_traits<T>());
 	}
 
-	template<typename T, typename Alloc>
-	static inline void string_reset(buffer<T, Alloc>& b, T* storage, size_t capacity) {
-		b.first = b.last = storage;
-		b.capacity = storage + capacity;
-		storage[0] = 0;
-	}
-
-	template<typename T, typename Alloc>
-	static inline void string_reset(buffer<T, Alloc>& b, T* storage, size_t capacity, size_t size) {
-		b.first = storage;
-		b.last = storage + size;
-		b.capacity = storage + capacity;
-		storage[size] = 0;
-	}
-
 	template<typename T, typename Alloc>
 	static inline void buffer_alloc(buffer<T, Alloc>& b, size_t count) {
 		typedef T* pointer;
@@ -207,11 +192,6 @@ namespace tinystl {
 			buffer_realloc(b, ((b.last - b.first + count) * 3) / 2, padding, nodealloc);
 	}
 
-	template<typename T, typename Alloc>
-	static inline void string_reserve(buffer<T, Alloc>& b, T* storage, size_t capacity) {
-		buffer_reserve(b, capacity, 1, b.first == storage);
-	}
-
 	template<typename T, typename Alloc>
 	static inline void buffer_resize(buffer<T, Alloc>& b, size_t size) {
 		buffer_reserve(b, size);
@@ -230,24 +210,6 @@ namespace tinystl {
 		b.last = b.first + size;
 	}
 
-	template<typename T, typename Alloc>
-	static inline void string_resize(buffer<T, Alloc>& b, T* storage, size_t size) {
-		string_reserve(b, storage, size);
-
-		buffer_fill_urange(b.last, b.first + size + 1);
-		b.last = b.first + size;
-		*b.last = 0;
-	}
-
-	template<typename T, typename Alloc>
-	static inline void string_resize(buffer<T, Alloc>& b, size_t size, const T& value) {
-		string_reserve(b, size);
-
-		buffer_fill_urange(b.last, b.first + size + 1, value);
-		b.last = b.first + size;
-		*b.last = 0;
-	}
-
 	template<typename T, typename Alloc>
 	static inline void buffer_shrink_to_fit(buffer<T, Alloc>& b, size_t padding = 0) {
 		if (b.capacity != b.last) {
@@ -274,12 +236,6 @@ namespace tinystl {
 		b.last = b.first;
 	}
 
-	template<typename T, typename Alloc>
-	static inline void string_clear(buffer<T, Alloc>& b) {
-		b.last = b.first;
-		*b.last = 0;
-	}
-
 	template<typename T, typename Alloc>
 	static inline T* buffer_insert_spread(buffer<T, Alloc>& b, T* where, size_t count, size_t padding = 0, bool nodealloc = false) {
 		const size_t offset = (size_t)(where - b.first);
@@ -305,30 +261,6 @@ namespace tinystl {
 		return where;
 	}
 
-	template<typename T, typename Alloc>
-	static inline void string_insert(buffer<T, Alloc>& b, T* storage, T* where, const T* first, const T* last) {
-		const size_t count = last - first;
-		where = buffer_insert_spread(b, where, count, 1, b.first == storage);
-		buffer_copy_urange(where, first, last);
-		*b.last = 0;
-	}
-
-	template<typename T, typename Alloc>
-	static inline void string_copy(buffer<T, Alloc>& b, const T* first, const T* last) {
-		buffer_copy_urange(b.last, first, last);
-		b.last += last - first;
-		*b.last = 0;
-	}
-
-	template<typename T, typename Alloc>
-	static inline void string_append(buffer<T, Alloc>& b, T* storage, const T* first, const T* last) {
-		const size_t newsize = (size_t)((b.last - b.first) + (last - first));
-		buffer_grow(b, newsize, 1, b.first == storage);
-		buffer_copy_urange(b.last, first, last);
-		b.last += last - first;
-		*b.last = 0;
-	}
-
 	template<typename T, typename Alloc>
 	static inline T* buffer_insert(buffer<T, Alloc>& b, T* where, const T& value) {
 		where = buffer_insert_spread(b, where, 1);
@@ -392,25 +324,12 @@ namespace tinystl {
 		return first;
 	}
 
-	template<typename T, typename Alloc>
-	static inline T* string_erase(buffer<T, Alloc>& b, T* first, T* last) {
-		buffer_erase(b, first, last);
-		*b.last = 0;
-		return first;
-	}
-
 	template<typename T, typename Alloc>
 	static inline void buffer_pop(buffer<T, Alloc>& b) {
 		buffer_destroy_range(b.last - 1, b.last);
 		b.last--;
 	}
 
-	template<typename T, typename Alloc>
-	static inline void string_pop(buffer<T, Alloc>& b) {
-		b.last--;
-		*b.last = 0;
-	}
-
 	template<typename T, typename Alloc>
 	static inline T* buffer_erase_unordered(buffer<T, Alloc>& b, T* first, T* last) {
 		typedef T* pointer;
@@ -426,6 +345,39 @@ namespace tinystl {
 		return first;
 	}
 
+	template<typename T, typename Alloc, typename Predicate>
+	static inline size_t buffer_erase_if(buffer<T, Alloc>& b, Predicate pred) {
+		typedef T* pointer;
+		pointer dest = b.first;
+		for (pointer it = b.first, end = b.last; it != end; ++it) {
+			if (pred(*it))
+				continue;
+			if (dest != it)
+				move(*dest, *it);
+			++dest;
+		}
+
+		const size_t count = (size_t)(b.last - dest);
+		buffer_destroy_range(dest, b.last);
+
+		b.last = dest;
+		return count;
+	}
+
+	template<typename T, typename Alloc, typename Predicate>
+	static inline size_t buffer_erase_if_unordered(buffer<T, Alloc>& b, Predicate pred) {
+		typedef T* pointer;
+		const pointer last = b.last;
+		for (pointer it = b.first; it != b.last; ) {
+			if (pred(*it))
+				buffer_erase_unordered(b, it, it + 1);
+			else
+				++it;
+		}
+
+		return (size_t)(last - b.last);
+	}
+
 	template<typename T, typename Alloc>
 	static inline void buffer_swap(buffer<T, Alloc>& b, buffer<T, Alloc>& other) {
 		typedef T* pointer;
@@ -0,0 +1,289 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_DENSE_MAP_H
+#define TINYSTL_DENSE_MAP_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/hash_base.h>
+#include <TINYSTL/vector.h>
+
+namespace tinystl {
+
+	struct dense_map_slot {
+		size_t hash;
+		size_t index;
+	};
+
+	// Keys and values are kept in two contiguous arrays, indexed by an open
+	// addressed (linear probing) table of slots. Erase moves the last entry
+	// into the hole, so the arrays never contain gaps.
+	template<typename Key, typename Value, typename Alloc = TINYSTL_ALLOCATOR>
+	class dense_map {
+	public:
+		typedef pair<Key, Value> value_type;
+
+		size_t size() const;
+		bool empty() const;
+		void clear();
+		void reserve(size_t count);
+
+		const Key* keys() const;
+		const Value* values() const;
+		Value* values();
+
+		const Value* find(const Key& key) const;
+		Value* find(const Key& key);
+		pair<Value*, bool> insert(const pair<Key, Value>& p);
+		pair<Value*, bool> insert(pair<Key, Value>&& p);
+		pair<Value*, bool> emplace(pair<Key, Value>&& p);
+		size_t erase(const Key& key);
+
+		Value& operator[](const Key& key);
+
+		void swap(dense_map& other);
+
+	private:
+		static const size_t c_empty = (size_t)-1;
+
+		size_t lookup(const Key& key, size_t keyhash) const;
+		size_t insert_slot(const Key& key, size_t keyhash, bool& inserted);
+		void rehash(size_t nslots);
+
+		vector<Key, Alloc> m_keys;
+		vector<Value, Alloc> m_values;
+		vector<dense_map_slot, Alloc> m_slots;
+	};
+
+	template<typename Key, typename Value, typename Alloc>
+	inline size_t dense_map<Key, Value, Alloc>::size() const {
+		return m_keys.size();
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline bool dense_map<Key, Value, Alloc>::empty() const {
+		return m_keys.empty();
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void dense_map<Key, Value, Alloc>::clear() {
+		m_keys.clear();
+		m_values.clear();
+
+		const dense_map_slot empty = { 0, c_empty };
+		for (dense_map_slot* it = m_slots.begin(), *end = m_slots.end(); it != end; ++it)
+			*it = empty;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void dense_map<Key, Value, Alloc>::reserve(size_t count) {
+		m_keys.reserve(count);
+		m_values.reserve(count);
+
+		size_t nslots = m_slots.size() ? m_slots.size() : 8;
+		while (nslots * 3 < count * 4)
+			nslots *= 2;
+		if (nslots != m_slots.size())
+			rehash(nslots);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline const Key* dense_map<Key, Value, Alloc>::keys() const {
+		return m_keys.data();
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline const Value* dense_map<Key, Value, Alloc>::values() const {
+		return m_values.data();
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline Value* dense_map<Key, Value, Alloc>::values() {
+		return m_values.data();
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline size_t dense_map<Key, Value, Alloc>::lookup(const Key& key, size_t keyhash) const {
+		const size_t mask = m_slots.size() - 1;
+		for (size_t pos = keyhash & mask; ; pos = (pos + 1) & mask) {
+			const dense_map_slot& slot = m_slots[pos];
+			if (slot.index == c_empty)
+				return pos;
+			if (slot.hash == keyhash && m_keys[slot.index] == key)
+				return pos;
+		}
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline const Value* dense_map<Key, Value, Alloc>::find(const Key& key) const {
+		if (m_keys.empty())
+			return 0;
+
+		const size_t index = m_slots[lookup(key, hash(key))].index;
+		return (index != c_empty) ? m_values.data() + index : 0;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline Value* dense_map<Key, Value, Alloc>::find(const Key& key) {
+		if (m_keys.empty())
+			return 0;
+
+		const size_t index = m_slots[lookup(key, hash(key))].index;
+		return (index != c_empty) ? m_values.data() + index : 0;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void dense_map<Key, Value, Alloc>::rehash(size_t nslots) {
+		const dense_map_slot empty = { 0, c_empty };
+		vector<dense_map_slot, Alloc> slots(nslots, empty);
+
+		const size_t mask = nslots - 1;
+		for (const dense_map_slot* it = m_slots.begin(), *end = m_slots.end(); it != end; ++it) {
+			if (it->index == c_empty)
+				continue;
+
+			size_t pos = it->hash & mask;
+			while (slots[pos].index != c_empty)
+				pos = (pos + 1) & mask;
+			slots[pos] = *it;
+		}
+
+		m_slots.swap(slots);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline size_t dense_map<Key, Value, Alloc>::insert_slot(const Key& key, size_t keyhash, bool& inserted) {
+		size_t pos = 0;
+		if (!m_slots.empty()) {
+			pos = lookup(key, keyhash);
+			if (m_slots[pos].index != c_empty) {
+				inserted = false;
+				return m_slots[pos].index;
+			}
+		}
+
+		const size_t index = m_keys.size();
+		if (m_slots.empty() || (index + 1) * 4 > m_slots.size() * 3) {
+			rehash(m_slots.empty() ? 8 : m_slots.size() * 2);
+			pos = lookup(key, keyhash);
+		}
+
+		m_slots[pos].hash = keyhash;
+		m_slots[pos].index = index;
+		inserted = true;
+		return index;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline pair<Value*, bool> dense_map<Key, Value, Alloc>::insert(const pair<Key, Value>& p) {
+		pair<Value*, bool> result;
+		const size_t index = insert_slot(p.first, hash(p.first), result.second);
+		if (result.second) {
+			m_keys.push_back(p.first);
+			m_values.push_back(p.second);
+		}
+
+		result.first = m_values.data() + index;
+		return result;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline pair<Value*, bool> dense_map<Key, Value, Alloc>::insert(pair<Key, Value>&& p) {
+		pair<Value*, bool> result;
+		const size_t index = insert_slot(p.first, hash(p.first), result.second);
+		if (result.second) {
+			m_keys.push_back(static_cast<Key&&>(p.first));
+			m_values.push_back(static_cast<Value&&>(p.second));
+		}
+
+		result.first = m_values.data() + index;
+		return result;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline pair<Value*, bool> dense_map<Key, Value, Alloc>::emplace(pair<Key, Value>&& p) {
+		return insert(static_cast<pair<Key, Value>&&>(p));
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline size_t dense_map<Key, Value, Alloc>::erase(const Key& key) {
+		if (m_keys.empty())
+			return 0;
+
+		size_t hole = lookup(key, hash(key));
+		const size_t index = m_slots[hole].index;
+		if (index == c_empty)
+			return 0;
+
+		// backward shift deletion keeps probe sequences intact without tombstones
+		const size_t mask = m_slots.size() - 1;
+		for (size_t pos = (hole + 1) & mask; m_slots[pos].index != c_empty; pos = (pos + 1) & mask) {
+			const size_t home = m_slots[pos].hash & mask;
+			if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+				m_slots[hole] = m_slots[pos];
+				hole = pos;
+			}
+		}
+		m_slots[hole].index = c_empty;
+
+		const size_t last = m_keys.size() - 1;
+		m_keys.erase_unordered(m_keys.begin() + index);
+		m_values.erase_unordered(m_values.begin() + index);
+
+		// re-point the slot of the entry that was moved into the hole
+		if (index != last) {
+			for (size_t pos = hash(m_keys[index]) & mask; ; pos = (pos + 1) & mask) {
+				if (m_slots[pos].index == last) {
+					m_slots[pos].index = index;
+					break;
+				}
+			}
+		}
+
+		return 1;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline Value& dense_map<Key, Value, Alloc>::operator[](const Key& key) {
+		bool inserted;
+		const size_t index = insert_slot(key, hash(key), inserted);
+		if (inserted) {
+			m_keys.push_back(key);
+			m_values.emplace_back();
+		}
+
+		return m_values[index];
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void dense_map<Key, Value, Alloc>::swap(dense_map& other) {
+		m_keys.swap(other.m_keys);
+		m_values.swap(other.m_values);
+		m_slots.swap(other.m_slots);
+	}
+}
+#endif
@@ -31,7 +31,7 @@
 
 namespace tinystl {
 
-	static inline size_t hash_string(const char* str, size_t len) {
+	static constexpr size_t hash_string(const char* str, size_t len) {
 		// Implementation of sdbm a public domain string hash from Ozan Yigit
 		// see: http://www.eecs.harvard.edu/margo/papers/usenix91/paper.ps
 
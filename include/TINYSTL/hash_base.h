@@ -114,6 +114,7 @@ namespace tinystl {
 	template<typename Key, typename Value>
 	struct unordered_hash_node {
 		unordered_hash_node(const Key& key, const Value& value);
+		unordered_hash_node(const Key& key, Value&& value);
 		unordered_hash_node(Key&& key, Value&& value);
 
 		const Key first;
@@ -132,6 +133,13 @@ namespace tinystl {
 	{
 	}
 
+	template<typename Key, typename Value>
+	inline unordered_hash_node<Key, Value>::unordered_hash_node(const Key& key, Value&& value)
+		: first(key)
+		, second(static_cast<Value&&>(value))
+	{
+	}
+
 	template<typename Key, typename Value>
 	inline unordered_hash_node<Key, Value>::unordered_hash_node(Key&& key, Value&& value)
 		: first(static_cast<Key&&>(key))
@@ -164,6 +172,152 @@ namespace tinystl {
 	{
 	}
 
+	template<typename Key, typename Value, typename Alloc>
+	struct unordered_hash_node_handle {
+		unordered_hash_node_handle();
+		explicit unordered_hash_node_handle(unordered_hash_node<Key, Value>* node);
+		unordered_hash_node_handle(unordered_hash_node_handle&& other);
+		~unordered_hash_node_handle();
+
+		unordered_hash_node_handle& operator=(unordered_hash_node_handle&& other);
+
+		bool empty() const;
+		const Key& key() const;
+		Value& mapped() const;
+
+		void swap(unordered_hash_node_handle& other);
+
+		unordered_hash_node<Key, Value>* node;
+
+	private:
+		unordered_hash_node_handle(const unordered_hash_node_handle&);
+		unordered_hash_node_handle& operator=(const unordered_hash_node_handle&);
+	};
+
+	template<typename Key, typename Value, typename Alloc>
+	inline unordered_hash_node_handle<Key, Value, Alloc>::unordered_hash_node_handle()
+		: node(0)
+	{
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline unordered_hash_node_handle<Key, Value, Alloc>::unordered_hash_node_handle(unordered_hash_node<Key, Value>* node)
+		: node(node)
+	{
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline unordered_hash_node_handle<Key, Value, Alloc>::unordered_hash_node_handle(unordered_hash_node_handle&& other)
+		: node(other.node)
+	{
+		other.node = 0;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline unordered_hash_node_handle<Key, Value, Alloc>::~unordered_hash_node_handle() {
+		if (node) {
+			node->~unordered_hash_node<Key, Value>();
+			Alloc::static_deallocate(node, sizeof(unordered_hash_node<Key, Value>));
+		}
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline unordered_hash_node_handle<Key, Value, Alloc>& unordered_hash_node_handle<Key, Value, Alloc>::operator=(unordered_hash_node_handle&& other) {
+		unordered_hash_node_handle(static_cast<unordered_hash_node_handle&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline bool unordered_hash_node_handle<Key, Value, Alloc>::empty() const {
+		return node == 0;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline const Key& unordered_hash_node_handle<Key, Value, Alloc>::key() const {
+		return node->first;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline Value& unordered_hash_node_handle<Key, Value, Alloc>::mapped() const {
+		return node->second;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void unordered_hash_node_handle<Key, Value, Alloc>::swap(unordered_hash_node_handle& other) {
+		unordered_hash_node<Key, Value>* tnode = node;
+		node = other.node, other.node = tnode;
+	}
+
+	template<typename Key, typename Alloc>
+	struct unordered_hash_node_handle<Key, void, Alloc> {
+		unordered_hash_node_handle();
+		explicit unordered_hash_node_handle(unordered_hash_node<Key, void>* node);
+		unordered_hash_node_handle(unordered_hash_node_handle&& other);
+		~unordered_hash_node_handle();
+
+		unordered_hash_node_handle& operator=(unordered_hash_node_handle&& other);
+
+		bool empty() const;
+		const Key& value() const;
+
+		void swap(unordered_hash_node_handle& other);
+
+		unordered_hash_node<Key, void>* node;
+
+	private:
+		unordered_hash_node_handle(const unordered_hash_node_handle&);
+		unordered_hash_node_handle& operator=(const unordered_hash_node_handle&);
+	};
+
+	template<typename Key, typename Alloc>
+	inline unordered_hash_node_handle<Key, void, Alloc>::unordered_hash_node_handle()
+		: node(0)
+	{
+	}
+
+	template<typename Key, typename Alloc>
+	inline unordered_hash_node_handle<Key, void, Alloc>::unordered_hash_node_handle(unordered_hash_node<Key, void>* node)
+		: node(node)
+	{
+	}
+
+	template<typename Key, typename Alloc>
+	inline unordered_hash_node_handle<Key, void, Alloc>::unordered_hash_node_handle(unordered_hash_node_handle&& other)
+		: node(other.node)
+	{
+		other.node = 0;
+	}
+
+	template<typename Key, typename Alloc>
+	inline unordered_hash_node_handle<Key, void, Alloc>::~unordered_hash_node_handle() {
+		if (node) {
+			node->~unordered_hash_node<Key, void>();
+			Alloc::static_deallocate(node, sizeof(unordered_hash_node<Key, void>));
+		}
+	}
+
+	template<typename Key, typename Alloc>
+	inline unordered_hash_node_handle<Key, void, Alloc>& unordered_hash_node_handle<Key, void, Alloc>::operator=(unordered_hash_node_handle&& other) {
+		unordered_hash_node_handle(static_cast<unordered_hash_node_handle&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Alloc>
+	inline bool unordered_hash_node_handle<Key, void, Alloc>::empty() const {
+		return node == 0;
+	}
+
+	template<typename Key, typename Alloc>
+	inline const Key& unordered_hash_node_handle<Key, void, Alloc>::value() const {
+		return node->first;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void unordered_hash_node_handle<Key, void, Alloc>::swap(unordered_hash_node_handle& other) {
+		unordered_hash_node<Key, void>* tnode = node;
+		node = other.node, other.node = tnode;
+	}
+
 	template<typename Key, typename Value>
 	static inline void unordered_hash_node_insert(unordered_hash_node<Key, Value>* node, size_t hash, unordered_hash_node<Key, Value>** buckets, size_t nbuckets) {
 		size_t bucket = hash & (nbuckets - 1);
@@ -214,6 +368,45 @@ namespace tinystl {
 			next->prev = where->prev;
 	}
 
+	template<typename Alloc, typename Key, typename Value, typename Predicate>
+	static inline size_t unordered_hash_node_erase_if(unordered_hash_node<Key, Value>** buckets, size_t nbuckets, Predicate pred) {
+		typedef unordered_hash_node<Key, Value>* pointer;
+
+		// unlink matching nodes one bucket at a time, then repair the
+		// pointers of buckets that were emptied in a single backward pass
+		size_t count = 0;
+		pointer first = buckets[0];
+		for (size_t bucket = 0; bucket != nbuckets; ++bucket) {
+			const pointer last = buckets[bucket + 1];
+			pointer kept = 0;
+			for (pointer it = first; it != last; ) {
+				const pointer next = it->next;
+				if (pred(*it)) {
+					if (it->prev)
+						it->prev->next = next;
+					if (next)
+						next->prev = it->prev;
+
+					it->~unordered_hash_node<Key, Value>();
+					Alloc::static_deallocate(it, sizeof(unordered_hash_node<Key, Value>));
+					++count;
+				} else if (!kept) {
+					kept = it;
+				}
+				it = next;
+			}
+
+			buckets[bucket] = kept;
+			first = last;
+		}
+
+		for (size_t bucket = nbuckets; bucket-- != 0; )
+			if (!buckets[bucket])
+				buckets[bucket] = buckets[bucket + 1];
+
+		return count;
+	}
+
 	template<typename Node>
 	struct unordered_hash_iterator {
 		Node* operator->() const;
@@ -0,0 +1,229 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_HASHED_STRING_H
+#define TINYSTL_HASHED_STRING_H
+
+#include <TINYSTL/hash.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	// A string key that hashes its characters once, when it is assigned.
+	// Container lookups, inserts and rehashes then reuse the stored hash,
+	// and comparisons reject most mismatches on the hash alone. The
+	// characters can only be replaced as a whole, which keeps the hash in
+	// step with them.
+	template<typename Alloc, size_t N = 0>
+	class basic_hashed_string {
+	public:
+		basic_hashed_string();
+		basic_hashed_string(const char* s);
+		basic_hashed_string(const char* s, size_t len);
+		basic_hashed_string(string_view v);
+		explicit basic_hashed_string(const basic_string<Alloc, N>& s);
+		explicit basic_hashed_string(basic_string<Alloc, N>&& s);
+
+		basic_hashed_string& operator=(string_view v);
+
+		void assign(const char* s, size_t len);
+		void clear();
+
+		const char* data() const;
+		const char* c_str() const;
+		size_t size() const;
+		bool empty() const;
+
+		const char& operator[](size_t idx) const;
+
+		typedef char value_type;
+		typedef const char* const_iterator;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		const basic_string<Alloc, N>& str() const;
+		string_view view() const;
+		operator string_view() const;
+
+		size_t hash_value() const;
+
+		void swap(basic_hashed_string& other);
+
+	private:
+		basic_string<Alloc, N> m_str;
+		size_t m_hash;
+	};
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>::basic_hashed_string()
+		: m_hash(hash_string("", 0))
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>::basic_hashed_string(const char* s)
+		: m_str(s)
+		, m_hash(hash_string(m_str.data(), m_str.size()))
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>::basic_hashed_string(const char* s, size_t len)
+		: m_str(s, len)
+		, m_hash(hash_string(m_str.data(), m_str.size()))
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>::basic_hashed_string(string_view v)
+		: m_str(v)
+		, m_hash(hash_string(m_str.data(), m_str.size()))
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>::basic_hashed_string(const basic_string<Alloc, N>& s)
+		: m_str(s)
+		, m_hash(hash_string(m_str.data(), m_str.size()))
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>::basic_hashed_string(basic_string<Alloc, N>&& s)
+		: m_str(static_cast<basic_string<Alloc, N>&&>(s))
+		, m_hash(hash_string(m_str.data(), m_str.size()))
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>& basic_hashed_string<Alloc, N>::operator=(string_view v) {
+		assign(v.data(), v.size());
+		return *this;
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_hashed_string<Alloc, N>::assign(const char* s, size_t len) {
+		m_str.assign(s, s + len);
+		m_hash = hash_string(m_str.data(), m_str.size());
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_hashed_string<Alloc, N>::clear() {
+		m_str.clear();
+		m_hash = hash_string("", 0);
+	}
+
+	template<typename Alloc, size_t N>
+	inline const char* basic_hashed_string<Alloc, N>::data() const {
+		return m_str.data();
+	}
+
+	template<typename Alloc, size_t N>
+	inline const char* basic_hashed_string<Alloc, N>::c_str() const {
+		return m_str.c_str();
+	}
+
+	template<typename Alloc, size_t N>
+	inline size_t basic_hashed_string<Alloc, N>::size() const {
+		return m_str.size();
+	}
+
+	template<typename Alloc, size_t N>
+	inline bool basic_hashed_string<Alloc, N>::empty() const {
+		return m_str.empty();
+	}
+
+	template<typename Alloc, size_t N>
+	inline const char& basic_hashed_string<Alloc, N>::operator[](size_t idx) const {
+		return m_str[idx];
+	}
+
+	template<typename Alloc, size_t N>
+	inline typename basic_hashed_string<Alloc, N>::const_iterator basic_hashed_string<Alloc, N>::begin() const {
+		return m_str.begin();
+	}
+
+	template<typename Alloc, size_t N>
+	inline typename basic_hashed_string<Alloc, N>::const_iterator basic_hashed_string<Alloc, N>::end() const {
+		return m_str.end();
+	}
+
+	template<typename Alloc, size_t N>
+	inline const basic_string<Alloc, N>& basic_hashed_string<Alloc, N>::str() const {
+		return m_str;
+	}
+
+	template<typename Alloc, size_t N>
+	inline string_view basic_hashed_string<Alloc, N>::view() const {
+		return string_view(m_str.data(), m_str.size());
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_hashed_string<Alloc, N>::operator string_view() const {
+		return string_view(m_str.data(), m_str.size());
+	}
+
+	template<typename Alloc, size_t N>
+	inline size_t basic_hashed_string<Alloc, N>::hash_value() const {
+		return m_hash;
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_hashed_string<Alloc, N>::swap(basic_hashed_string& other) {
+		m_str.swap(other.m_str);
+		const size_t tmp = m_hash;
+		m_hash = other.m_hash;
+		other.m_hash = tmp;
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator==(const basic_hashed_string<Alloc, N>& lhs, const basic_hashed_string<Alloc, N>& rhs) {
+		const size_t lsize = lhs.size();
+		return lhs.hash_value() == rhs.hash_value() && lsize == rhs.size() && string_equal(lhs.data(), rhs.data(), lsize);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator!=(const basic_hashed_string<Alloc, N>& lhs, const basic_hashed_string<Alloc, N>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator<(const basic_hashed_string<Alloc, N>& lhs, const basic_hashed_string<Alloc, N>& rhs) {
+		return lhs.view() < rhs.view();
+	}
+
+	template<typename Alloc, size_t N>
+	static inline size_t hash(const basic_hashed_string<Alloc, N>& value) {
+		return value.hash_value();
+	}
+
+	typedef basic_hashed_string<TINYSTL_ALLOCATOR> hashed_string;
+}
+
+#endif
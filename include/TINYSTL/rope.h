@@ -0,0 +1,516 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_ROPE_H
+#define TINYSTL_ROPE_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/shared_string.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	// A piece of text: length characters at offset in a shared chunk. Pieces
+	// are kept in order in a treap keyed implicitly by position, so total is
+	// the number of characters in the subtree.
+	struct rope_node {
+		rope_node* left;
+		rope_node* right;
+		shared_string_block* chunk;
+		size_t offset;
+		size_t length;
+		size_t total;
+		unsigned priority;
+	};
+
+	static inline size_t rope_total(const rope_node* node) {
+		return node ? node->total : 0;
+	}
+
+	static inline void rope_update(rope_node* node) {
+		node->total = rope_total(node->left) + node->length + rope_total(node->right);
+	}
+
+	static inline const char* rope_chars(const rope_node* node) {
+		return (const char*)(node->chunk + 1) + node->offset;
+	}
+
+	static inline rope_node* rope_merge(rope_node* lhs, rope_node* rhs) {
+		if(!lhs)
+			return rhs;
+		if(!rhs)
+			return lhs;
+
+		if(lhs->priority > rhs->priority) {
+			lhs->right = rope_merge(lhs->right, rhs);
+			rope_update(lhs);
+			return lhs;
+		}
+
+		rhs->left = rope_merge(lhs, rhs->left);
+		rope_update(rhs);
+		return rhs;
+	}
+
+	// A text buffer for large documents edited in place. Characters live in
+	// immutable reference counted chunks, and the text is a balanced tree of
+	// pieces of those chunks, so insert and erase cost O(log n) regardless of
+	// the document size, and copies and substrings share the characters.
+	template<typename Alloc = TINYSTL_ALLOCATOR>
+	class basic_rope {
+	public:
+		static const size_t npos = (size_t)-1;
+
+		basic_rope();
+		basic_rope(const basic_rope& other);
+		basic_rope(basic_rope&& other);
+		explicit basic_rope(string_view s);
+		~basic_rope();
+
+		basic_rope& operator=(const basic_rope& other);
+		basic_rope& operator=(basic_rope&& other);
+
+		size_t size() const;
+		bool empty() const;
+		void clear();
+
+		char operator[](size_t pos) const;
+
+		void insert(size_t pos, string_view s);
+		void append(string_view s);
+		void erase(size_t pos, size_t len = npos);
+
+		basic_rope substr(size_t pos, size_t len = npos) const;
+		size_t copy(char* dest, size_t count, size_t pos = 0) const;
+
+		// the contiguous characters from pos to the end of their piece
+		string_view chunk(size_t pos) const;
+
+		class chunk_iterator {
+		public:
+			string_view operator*() const { return m_chunk; }
+			const string_view* operator->() const { return &m_chunk; }
+			chunk_iterator& operator++() { m_pos += m_chunk.size(); m_chunk = m_rope->chunk(m_pos); return *this; }
+			bool operator==(const chunk_iterator& other) const { return m_pos == other.m_pos; }
+			bool operator!=(const chunk_iterator& other) const { return m_pos != other.m_pos; }
+
+		private:
+			friend class basic_rope;
+			chunk_iterator(const basic_rope* rope, size_t pos) : m_rope(rope), m_pos(pos), m_chunk(rope->chunk(pos)) {}
+
+			const basic_rope* m_rope;
+			size_t m_pos;
+			string_view m_chunk;
+		};
+
+		struct chunk_range {
+			chunk_iterator begin() const { return chunk_iterator(rope, 0); }
+			chunk_iterator end() const { return chunk_iterator(rope, rope->size()); }
+			const basic_rope* rope;
+		};
+
+		chunk_range chunks() const;
+
+		void swap(basic_rope& other);
+
+	private:
+		// characters are appended to a chunk of this size, larger inserts get their own
+		static const size_t c_chunk = 4096 - sizeof(shared_string_block);
+
+		rope_node* make_node(shared_string_block* chunk, size_t offset, size_t length);
+		rope_node* clone(const rope_node* node);
+		void destroy(rope_node* node);
+		void split(rope_node* node, size_t pos, rope_node*& lhs, rope_node*& rhs);
+		bool extend(rope_node* node, size_t pos, string_view s);
+		void collect(const rope_node* node, size_t first, size_t last, basic_rope& result) const;
+
+		rope_node* m_root;
+		// the chunk new characters are appended to; copies share it, but only the
+		// unused bytes past every piece are ever written, so sharing stays safe
+		shared_string_block* m_append;
+		size_t m_append_used;
+		unsigned m_seed;
+	};
+
+	template<typename Alloc>
+	inline basic_rope<Alloc>::basic_rope()
+		: m_root(0)
+		, m_append(0)
+		, m_append_used(0)
+		, m_seed(0x9e3779b9u)
+	{
+	}
+
+	template<typename Alloc>
+	inline basic_rope<Alloc>::basic_rope(const basic_rope& other)
+		: m_root(0)
+		, m_append(0)
+		, m_append_used(0)
+		, m_seed(other.m_seed)
+	{
+		m_root = clone(other.m_root);
+	}
+
+	template<typename Alloc>
+	inline basic_rope<Alloc>::basic_rope(basic_rope&& other)
+		: m_root(other.m_root)
+		, m_append(other.m_append)
+		, m_append_used(other.m_append_used)
+		, m_seed(other.m_seed)
+	{
+		other.m_root = 0;
+		other.m_append = 0;
+		other.m_append_used = 0;
+	}
+
+	template<typename Alloc>
+	inline basic_rope<Alloc>::basic_rope(string_view s)
+		: basic_rope()
+	{
+		append(s);
+	}
+
+	template<typename Alloc>
+	inline basic_rope<Alloc>::~basic_rope() {
+		clear();
+	}
+
+	template<typename Alloc>
+	inline basic_rope<Alloc>& basic_rope<Alloc>::operator=(const basic_rope& other) {
+		basic_rope(other).swap(*this);
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline basic_rope<Alloc>& basic_rope<Alloc>::operator=(basic_rope&& other) {
+		basic_rope(static_cast<basic_rope&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline size_t basic_rope<Alloc>::size() const {
+		return rope_total(m_root);
+	}
+
+	template<typename Alloc>
+	inline bool basic_rope<Alloc>::empty() const {
+		return m_root == 0;
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::clear() {
+		destroy(m_root);
+		m_root = 0;
+
+		if(m_append && shared_string_release(m_append))
+			Alloc::static_deallocate(m_append, sizeof(shared_string_block) + m_append->size);
+		m_append = 0;
+		m_append_used = 0;
+	}
+
+	template<typename Alloc>
+	inline rope_node* basic_rope<Alloc>::make_node(shared_string_block* chunk, size_t offset, size_t length) {
+		// xorshift32
+		m_seed ^= m_seed << 13;
+		m_seed ^= m_seed >> 17;
+		m_seed ^= m_seed << 5;
+
+		rope_node* node = (rope_node*)Alloc::static_allocate(sizeof(rope_node));
+		node->left = node->right = 0;
+		node->chunk = chunk;
+		node->offset = offset;
+		node->length = node->total = length;
+		node->priority = m_seed;
+		shared_string_acquire(chunk);
+		return node;
+	}
+
+	template<typename Alloc>
+	inline rope_node* basic_rope<Alloc>::clone(const rope_node* node) {
+		if(!node)
+			return 0;
+
+		rope_node* copy = (rope_node*)Alloc::static_allocate(sizeof(rope_node));
+		*copy = *node;
+		shared_string_acquire(copy->chunk);
+		copy->left = clone(node->left);
+		copy->right = clone(node->right);
+		return copy;
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::destroy(rope_node* node) {
+		while(node) {
+			destroy(node->left);
+			rope_node* right = node->right;
+			if(shared_string_release(node->chunk))
+				Alloc::static_deallocate(node->chunk, sizeof(shared_string_block) + node->chunk->size);
+			Alloc::static_deallocate(node, sizeof(rope_node));
+			node = right;
+		}
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::split(rope_node* node, size_t pos, rope_node*& lhs, rope_node*& rhs) {
+		if(!node) {
+			lhs = rhs = 0;
+			return;
+		}
+
+		const size_t lsize = rope_total(node->left);
+		if(pos <= lsize) {
+			split(node->left, pos, lhs, node->left);
+			rope_update(node);
+			rhs = node;
+		} else if(pos >= lsize + node->length) {
+			split(node->right, pos - lsize - node->length, node->right, rhs);
+			rope_update(node);
+			lhs = node;
+		} else {
+			// the split point is inside this piece: its tail becomes a new piece
+			const size_t head = pos - lsize;
+			rope_node* tail = make_node(node->chunk, node->offset + head, node->length - head);
+			rhs = rope_merge(tail, node->right);
+			node->right = 0;
+			node->length = head;
+			rope_update(node);
+			lhs = node;
+		}
+	}
+
+	template<typename Alloc>
+	inline bool basic_rope<Alloc>::extend(rope_node* node, size_t pos, string_view s) {
+		// grows the piece ending at pos in place when it ends where the append chunk does,
+		// so typing at one spot adds characters to a single piece
+		if(!node || pos == 0)
+			return false;
+
+		const size_t lsize = rope_total(node->left);
+		bool extended;
+		if(pos <= lsize) {
+			extended = extend(node->left, pos, s);
+		} else if(pos < lsize + node->length) {
+			return false;
+		} else if(pos > lsize + node->length) {
+			extended = extend(node->right, pos - lsize - node->length, s);
+		} else {
+			extended = node->chunk == m_append && node->offset + node->length == m_append_used && m_append->size - m_append_used >= s.size();
+			if(extended) {
+				buffer_copy_urange((char*)(m_append + 1) + m_append_used, s.data(), s.data() + s.size());
+				m_append_used += s.size();
+				node->length += s.size();
+			}
+		}
+
+		if(extended)
+			node->total += s.size();
+		return extended;
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::insert(size_t pos, string_view s) {
+		if(s.empty() || extend(m_root, pos, s))
+			return;
+
+		shared_string_block* chunk;
+		size_t offset = 0;
+		if(m_append && m_append->size - m_append_used >= s.size()) {
+			chunk = m_append;
+			offset = m_append_used;
+		} else {
+			const size_t capacity = (s.size() > c_chunk / 4) ? s.size() : c_chunk;
+			chunk = (shared_string_block*)Alloc::static_allocate(sizeof(shared_string_block) + capacity);
+			chunk->refs = 1;
+			chunk->size = capacity;
+
+			if(capacity == c_chunk) {
+				if(m_append && shared_string_release(m_append))
+					Alloc::static_deallocate(m_append, sizeof(shared_string_block) + m_append->size);
+				m_append = chunk;
+				m_append_used = 0;
+			}
+		}
+
+		buffer_copy_urange((char*)(chunk + 1) + offset, s.data(), s.data() + s.size());
+		rope_node* node = make_node(chunk, offset, s.size());
+		if(chunk == m_append)
+			m_append_used = offset + s.size();
+		else
+			shared_string_release(chunk);
+
+		rope_node* lhs;
+		rope_node* rhs;
+		split(m_root, pos, lhs, rhs);
+		m_root = rope_merge(rope_merge(lhs, node), rhs);
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::append(string_view s) {
+		insert(size(), s);
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::erase(size_t pos, size_t len) {
+		const size_t size = this->size();
+		if(pos > size)
+			pos = size;
+		if(len > size - pos)
+			len = size - pos;
+		if(!len)
+			return;
+
+		rope_node* lhs;
+		rope_node* middle;
+		rope_node* rhs;
+		split(m_root, pos, lhs, middle);
+		split(middle, len, middle, rhs);
+		destroy(middle);
+		m_root = rope_merge(lhs, rhs);
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::collect(const rope_node* node, size_t first, size_t last, basic_rope& result) const {
+		// appends the parts of the pieces in [first, last) of this subtree to result
+		while(node && first < last) {
+			const size_t lsize = rope_total(node->left);
+			if(first < lsize)
+				collect(node->left, first, last < lsize ? last : lsize, result);
+
+			const size_t begin = (first > lsize) ? first - lsize : 0;
+			const size_t end = (last - lsize < node->length) ? last - lsize : node->length;
+			if(last > lsize && begin < end)
+				result.m_root = rope_merge(result.m_root, result.make_node(node->chunk, node->offset + begin, end - begin));
+
+			const size_t skip = lsize + node->length;
+			if(last <= skip)
+				return;
+			first = (first > skip) ? first - skip : 0;
+			last -= skip;
+			node = node->right;
+		}
+	}
+
+	template<typename Alloc>
+	inline basic_rope<Alloc> basic_rope<Alloc>::substr(size_t pos, size_t len) const {
+		const size_t size = this->size();
+		if(pos > size)
+			pos = size;
+		if(len > size - pos)
+			len = size - pos;
+
+		basic_rope result;
+		collect(m_root, pos, pos + len, result);
+		return result;
+	}
+
+	template<typename Alloc>
+	inline size_t basic_rope<Alloc>::copy(char* dest, size_t count, size_t pos) const {
+		const size_t size = this->size();
+		if(pos > size)
+			pos = size;
+		if(count > size - pos)
+			count = size - pos;
+
+		for(size_t done = 0; done < count; ) {
+			const string_view piece = chunk(pos + done);
+			const size_t n = (piece.size() < count - done) ? piece.size() : count - done;
+			buffer_copy_urange(dest + done, piece.data(), piece.data() + n);
+			done += n;
+		}
+		return count;
+	}
+
+	template<typename Alloc>
+	inline string_view basic_rope<Alloc>::chunk(size_t pos) const {
+		for(const rope_node* node = m_root; node; ) {
+			const size_t lsize = rope_total(node->left);
+			if(pos < lsize) {
+				node = node->left;
+			} else if(pos - lsize < node->length) {
+				const size_t skip = pos - lsize;
+				return string_view(rope_chars(node) + skip, node->length - skip);
+			} else {
+				pos -= lsize + node->length;
+				node = node->right;
+			}
+		}
+		return string_view();
+	}
+
+	template<typename Alloc>
+	inline char basic_rope<Alloc>::operator[](size_t pos) const {
+		return chunk(pos)[0];
+	}
+
+	template<typename Alloc>
+	inline typename basic_rope<Alloc>::chunk_range basic_rope<Alloc>::chunks() const {
+		const chunk_range range = { this };
+		return range;
+	}
+
+	template<typename Alloc>
+	inline void basic_rope<Alloc>::swap(basic_rope& other) {
+		rope_node* root = m_root;
+		m_root = other.m_root;
+		other.m_root = root;
+
+		shared_string_block* append = m_append;
+		m_append = other.m_append;
+		other.m_append = append;
+
+		const size_t append_used = m_append_used;
+		m_append_used = other.m_append_used;
+		other.m_append_used = append_used;
+
+		const unsigned seed = m_seed;
+		m_seed = other.m_seed;
+		other.m_seed = seed;
+	}
+
+	template<typename Alloc>
+	inline bool operator==(const basic_rope<Alloc>& lhs, string_view rhs) {
+		if(lhs.size() != rhs.size())
+			return false;
+
+		size_t pos = 0;
+		for(typename basic_rope<Alloc>::chunk_iterator it = lhs.chunks().begin(), end = lhs.chunks().end(); it != end; ++it) {
+			if(!string_equal(it->data(), rhs.data() + pos, it->size()))
+				return false;
+			pos += it->size();
+		}
+		return true;
+	}
+
+	template<typename Alloc>
+	inline bool operator!=(const basic_rope<Alloc>& lhs, string_view rhs) { return !(lhs == rhs); }
+
+	typedef basic_rope<TINYSTL_ALLOCATOR> rope;
+}
+
+#endif
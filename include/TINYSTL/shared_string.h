@@ -0,0 +1,293 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_SHARED_STRING_H
+#define TINYSTL_SHARED_STRING_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	// header of a heap shared_string, followed by the characters and a null terminator
+	struct shared_string_block {
+		long refs;
+		size_t size;
+	};
+
+	static inline void shared_string_acquire(shared_string_block* block) {
+#if defined(_MSC_VER)
+		_InterlockedIncrement(&block->refs);
+#else
+		__atomic_fetch_add(&block->refs, 1, __ATOMIC_RELAXED);
+#endif
+	}
+
+	// returns true when the last reference was dropped
+	static inline bool shared_string_release(shared_string_block* block) {
+#if defined(_MSC_VER)
+		return _InterlockedDecrement(&block->refs) == 0;
+#else
+		return __atomic_sub_fetch(&block->refs, 1, __ATOMIC_ACQ_REL) == 0;
+#endif
+	}
+
+	// An immutable string. Short values are stored inline, longer ones in
+	// a reference counted heap block, so every copy is at most a pointer
+	// copy and an atomic increment.
+	template<typename Alloc>
+	class basic_shared_string {
+	public:
+		basic_shared_string();
+		basic_shared_string(const basic_shared_string& other);
+		basic_shared_string(basic_shared_string&& other);
+		basic_shared_string(const char* s);
+		basic_shared_string(const char* s, size_t len);
+		explicit basic_shared_string(string_view v);
+		~basic_shared_string();
+
+		basic_shared_string& operator=(const basic_shared_string& other);
+		basic_shared_string& operator=(basic_shared_string&& other);
+
+		const char* data() const;
+		const char* c_str() const;
+		size_t size() const;
+		bool empty() const;
+
+		const char& operator[](size_t idx) const;
+
+		typedef char value_type;
+		typedef const char* const_iterator;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		string_view view() const;
+		operator string_view() const;
+
+		// true when both refer to the same heap block
+		bool shares(const basic_shared_string& other) const;
+
+		void swap(basic_shared_string& other);
+
+	private:
+		// the last byte holds c_nsmall - size for inline values and 0x80 for heap blocks
+		static const size_t c_nsmall = 3 * sizeof(void*) - 1;
+
+		bool is_small() const;
+
+		union {
+			shared_string_block* m_block;
+			char m_small[c_nsmall + 1];
+		};
+	};
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::basic_shared_string() {
+		m_small[0] = 0;
+		m_small[c_nsmall] = (char)c_nsmall;
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::basic_shared_string(const basic_shared_string& other) {
+		string_copy(m_small, other.m_small, c_nsmall + 1);
+		if(!is_small())
+			shared_string_acquire(m_block);
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::basic_shared_string(basic_shared_string&& other) {
+		string_copy(m_small, other.m_small, c_nsmall + 1);
+		other.m_small[0] = 0;
+		other.m_small[c_nsmall] = (char)c_nsmall;
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::basic_shared_string(const char* s)
+		: basic_shared_string(s, string_length(s))
+	{
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::basic_shared_string(const char* s, size_t len) {
+		if(len <= c_nsmall) {
+			string_copy(m_small, s, len);
+			m_small[len] = 0;
+			m_small[c_nsmall] = (char)(c_nsmall - len);
+			return;
+		}
+
+		shared_string_block* block = (shared_string_block*)Alloc::static_allocate(sizeof(shared_string_block) + len + 1);
+		block->refs = 1;
+		block->size = len;
+		char* first = (char*)(block + 1);
+		buffer_copy_urange(first, s, s + len);
+		first[len] = 0;
+
+		m_block = block;
+		m_small[c_nsmall] = (char)0x80;
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::basic_shared_string(string_view v)
+		: basic_shared_string(v.data(), v.size())
+	{
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::~basic_shared_string() {
+		if(!is_small() && shared_string_release(m_block))
+			Alloc::static_deallocate(m_block, sizeof(shared_string_block) + m_block->size + 1);
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>& basic_shared_string<Alloc>::operator=(const basic_shared_string& other) {
+		basic_shared_string(other).swap(*this);
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>& basic_shared_string<Alloc>::operator=(basic_shared_string&& other) {
+		basic_shared_string(static_cast<basic_shared_string&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline bool basic_shared_string<Alloc>::is_small() const {
+		return ((unsigned char)m_small[c_nsmall] & 0x80) == 0;
+	}
+
+	template<typename Alloc>
+	inline const char* basic_shared_string<Alloc>::data() const {
+		return is_small() ? m_small : (const char*)(m_block + 1);
+	}
+
+	template<typename Alloc>
+	inline const char* basic_shared_string<Alloc>::c_str() const {
+		return data();
+	}
+
+	template<typename Alloc>
+	inline size_t basic_shared_string<Alloc>::size() const {
+		return is_small() ? c_nsmall - (unsigned char)m_small[c_nsmall] : m_block->size;
+	}
+
+	template<typename Alloc>
+	inline bool basic_shared_string<Alloc>::empty() const {
+		return size() == 0;
+	}
+
+	template<typename Alloc>
+	inline const char& basic_shared_string<Alloc>::operator[](size_t idx) const {
+		return data()[idx];
+	}
+
+	template<typename Alloc>
+	inline typename basic_shared_string<Alloc>::const_iterator basic_shared_string<Alloc>::begin() const {
+		return data();
+	}
+
+	template<typename Alloc>
+	inline typename basic_shared_string<Alloc>::const_iterator basic_shared_string<Alloc>::end() const {
+		return data() + size();
+	}
+
+	template<typename Alloc>
+	inline string_view basic_shared_string<Alloc>::view() const {
+		return string_view(data(), size());
+	}
+
+	template<typename Alloc>
+	inline basic_shared_string<Alloc>::operator string_view() const {
+		return string_view(data(), size());
+	}
+
+	template<typename Alloc>
+	inline bool basic_shared_string<Alloc>::shares(const basic_shared_string& other) const {
+		return !is_small() && !other.is_small() && m_block == other.m_block;
+	}
+
+	template<typename Alloc>
+	inline void basic_shared_string<Alloc>::swap(basic_shared_string& other) {
+		char tmp[c_nsmall + 1];
+		string_copy(tmp, m_small, c_nsmall + 1);
+		string_copy(m_small, other.m_small, c_nsmall + 1);
+		string_copy(other.m_small, tmp, c_nsmall + 1);
+	}
+
+	template<typename Alloc>
+	inline bool operator==(const basic_shared_string<Alloc>& lhs, const basic_shared_string<Alloc>& rhs) {
+		const size_t lsize = lhs.size();
+		return lhs.shares(rhs) || (lsize == rhs.size() && string_equal(lhs.data(), rhs.data(), lsize));
+	}
+
+	template<typename Alloc>
+	inline bool operator!=(const basic_shared_string<Alloc>& lhs, const basic_shared_string<Alloc>& rhs) { return !(lhs == rhs); }
+
+	template<typename Alloc>
+	inline bool operator<(const basic_shared_string<Alloc>& lhs, const basic_shared_string<Alloc>& rhs) {
+		return lhs.view() < rhs.view();
+	}
+
+	template<typename Alloc>
+	inline bool operator==(const basic_shared_string<Alloc>& lhs, string_view rhs) {
+		const size_t lsize = lhs.size();
+		return lsize == rhs.size() && string_equal(lhs.data(), rhs.data(), lsize);
+	}
+
+	template<typename Alloc>
+	inline bool operator==(string_view lhs, const basic_shared_string<Alloc>& rhs) { return rhs == lhs; }
+
+	template<typename Alloc>
+	inline bool operator!=(const basic_shared_string<Alloc>& lhs, string_view rhs) { return !(lhs == rhs); }
+
+	template<typename Alloc>
+	inline bool operator!=(string_view lhs, const basic_shared_string<Alloc>& rhs) { return !(rhs == lhs); }
+
+	template<typename Alloc>
+	inline bool operator==(const basic_shared_string<Alloc>& lhs, const char* rhs) { return lhs == string_view(rhs, string_length(rhs)); }
+
+	template<typename Alloc>
+	inline bool operator==(const char* lhs, const basic_shared_string<Alloc>& rhs) { return rhs == string_view(lhs, string_length(lhs)); }
+
+	template<typename Alloc>
+	inline bool operator!=(const basic_shared_string<Alloc>& lhs, const char* rhs) { return !(lhs == rhs); }
+
+	template<typename Alloc>
+	inline bool operator!=(const char* lhs, const basic_shared_string<Alloc>& rhs) { return !(rhs == lhs); }
+
+	template<typename Alloc>
+	static inline size_t hash(const basic_shared_string<Alloc>& value) {
+		return hash_string(value.data(), value.size());
+	}
+
+	using shared_string = basic_shared_string<TINYSTL_ALLOCATOR>;
+}
+
+#endif
@@ -0,0 +1,359 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_SMALL_UNORDERED_MAP_H
+#define TINYSTL_SMALL_UNORDERED_MAP_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/hash_base.h>
+#include <TINYSTL/new.h>
+#include <TINYSTL/unordered_map.h>
+
+namespace tinystl {
+
+	// Holds up to N entries inline and finds them with a linear scan, without
+	// hashing or allocating. Inserting past N moves every entry into the
+	// wrapped unordered_map. Inline entries are linked like regular hash
+	// nodes, so both modes share unordered_map's iterators.
+	template<typename Key, typename Value, size_t N = 8, typename Alloc = TINYSTL_ALLOCATOR>
+	class small_unordered_map {
+	public:
+		small_unordered_map();
+		small_unordered_map(const small_unordered_map& other);
+		small_unordered_map(small_unordered_map&& other);
+		~small_unordered_map();
+
+		small_unordered_map& operator=(const small_unordered_map& other);
+		small_unordered_map& operator=(small_unordered_map&& other);
+
+		typedef pair<Key, Value> value_type;
+
+		typedef typename unordered_map<Key, Value, Alloc>::const_iterator const_iterator;
+		typedef typename unordered_map<Key, Value, Alloc>::iterator iterator;
+
+		iterator begin();
+		iterator end();
+
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		void clear();
+		bool empty() const;
+		size_t size() const;
+
+		const_iterator find(const Key& key) const;
+		iterator find(const Key& key);
+		pair<iterator, bool> insert(const pair<Key, Value>& p);
+		pair<iterator, bool> insert(pair<Key, Value>&& p);
+		pair<iterator, bool> emplace(pair<Key, Value>&& p);
+		void erase(const_iterator where);
+		void erase(const Key& key);
+
+		Value& operator[](const Key& key);
+
+		void swap(small_unordered_map& other);
+
+	private:
+
+		typedef unordered_hash_node<Key, Value>* pointer;
+
+		pointer small_nodes() const;
+		pointer small_find(const Key& key) const;
+		void small_link(size_t index);
+		void small_erase(pointer where);
+		void small_move(small_unordered_map& other);
+		void spill();
+
+		static_assert(N > 0, "use unordered_map when no entries are held inline");
+
+		size_t m_nsmall;
+		alignas(unordered_hash_node<Key, Value>) char m_small[N * sizeof(unordered_hash_node<Key, Value>)];
+		unordered_map<Key, Value, Alloc> m_large;
+	};
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline small_unordered_map<Key, Value, N, Alloc>::small_unordered_map()
+		: m_nsmall(0)
+	{
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline small_unordered_map<Key, Value, N, Alloc>::small_unordered_map(const small_unordered_map& other)
+		: m_nsmall(0)
+		, m_large(other.m_large)
+	{
+		const pointer nodes = small_nodes();
+		for (pointer it = other.small_nodes(), end = it + other.m_nsmall; it != end; ++it) {
+			new(placeholder(), nodes + m_nsmall) unordered_hash_node<Key, Value>(it->first, it->second);
+			small_link(m_nsmall++);
+		}
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline small_unordered_map<Key, Value, N, Alloc>::small_unordered_map(small_unordered_map&& other)
+		: m_nsmall(0)
+		, m_large(static_cast<unordered_map<Key, Value, Alloc>&&>(other.m_large))
+	{
+		small_move(other);
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline small_unordered_map<Key, Value, N, Alloc>::~small_unordered_map() {
+		clear();
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline small_unordered_map<Key, Value, N, Alloc>& small_unordered_map<Key, Value, N, Alloc>::operator=(const small_unordered_map& other) {
+		small_unordered_map(other).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline small_unordered_map<Key, Value, N, Alloc>& small_unordered_map<Key, Value, N, Alloc>::operator=(small_unordered_map&& other) {
+		small_unordered_map(static_cast<small_unordered_map&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::pointer small_unordered_map<Key, Value, N, Alloc>::small_nodes() const {
+		return (pointer)m_small;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::iterator small_unordered_map<Key, Value, N, Alloc>::begin() {
+		if (m_nsmall == 0)
+			return m_large.begin();
+
+		iterator it;
+		it.node = small_nodes();
+		return it;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::iterator small_unordered_map<Key, Value, N, Alloc>::end() {
+		iterator it;
+		it.node = 0;
+		return it;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::const_iterator small_unordered_map<Key, Value, N, Alloc>::begin() const {
+		if (m_nsmall == 0)
+			return m_large.begin();
+
+		const_iterator cit;
+		cit.node = small_nodes();
+		return cit;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::const_iterator small_unordered_map<Key, Value, N, Alloc>::end() const {
+		const_iterator cit;
+		cit.node = 0;
+		return cit;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::clear() {
+		for (pointer it = small_nodes(), end = it + m_nsmall; it != end; ++it)
+			it->~unordered_hash_node<Key, Value>();
+		m_nsmall = 0;
+
+		m_large.clear();
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline bool small_unordered_map<Key, Value, N, Alloc>::empty() const {
+		return m_nsmall == 0 && m_large.empty();
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline size_t small_unordered_map<Key, Value, N, Alloc>::size() const {
+		return m_nsmall + m_large.size();
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::pointer small_unordered_map<Key, Value, N, Alloc>::small_find(const Key& key) const {
+		for (pointer it = small_nodes(), end = it + m_nsmall; it != end; ++it)
+			if (it->first == key)
+				return it;
+
+		return 0;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::small_link(size_t index) {
+		const pointer nodes = small_nodes();
+		nodes[index].prev = index ? &nodes[index - 1] : 0;
+		nodes[index].next = (index + 1 < m_nsmall) ? &nodes[index + 1] : 0;
+		if (index)
+			nodes[index - 1].next = &nodes[index];
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::small_erase(pointer where) {
+		const pointer last = small_nodes() + m_nsmall - 1;
+
+		where->~unordered_hash_node<Key, Value>();
+		if (where != last) {
+			new(placeholder(), where) unordered_hash_node<Key, Value>(last->first, static_cast<Value&&>(last->second));
+			last->~unordered_hash_node<Key, Value>();
+		}
+
+		--m_nsmall;
+		if (where != last)
+			small_link((size_t)(where - small_nodes()));
+		if (m_nsmall)
+			small_nodes()[m_nsmall - 1].next = 0;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::small_move(small_unordered_map& other) {
+		const pointer nodes = small_nodes();
+		for (pointer it = other.small_nodes(), end = it + other.m_nsmall; it != end; ++it) {
+			new(placeholder(), nodes + m_nsmall) unordered_hash_node<Key, Value>(it->first, static_cast<Value&&>(it->second));
+			it->~unordered_hash_node<Key, Value>();
+			small_link(m_nsmall++);
+		}
+
+		other.m_nsmall = 0;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::spill() {
+		for (pointer it = small_nodes(), end = it + m_nsmall; it != end; ++it) {
+			m_large.insert(pair<Key, Value>(it->first, static_cast<Value&&>(it->second)));
+			it->~unordered_hash_node<Key, Value>();
+		}
+
+		m_nsmall = 0;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::iterator small_unordered_map<Key, Value, N, Alloc>::find(const Key& key) {
+		if (m_nsmall == 0)
+			return m_large.find(key);
+
+		iterator result;
+		result.node = small_find(key);
+		return result;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline typename small_unordered_map<Key, Value, N, Alloc>::const_iterator small_unordered_map<Key, Value, N, Alloc>::find(const Key& key) const {
+		if (m_nsmall == 0)
+			return m_large.find(key);
+
+		const_iterator result;
+		result.node = small_find(key);
+		return result;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline pair<typename small_unordered_map<Key, Value, N, Alloc>::iterator, bool> small_unordered_map<Key, Value, N, Alloc>::insert(const pair<Key, Value>& p) {
+		if (!m_large.empty())
+			return m_large.insert(p);
+
+		pair<iterator, bool> result;
+		result.second = false;
+
+		result.first.node = small_find(p.first);
+		if (result.first.node != 0)
+			return result;
+
+		if (m_nsmall == N) {
+			spill();
+			return m_large.insert(p);
+		}
+
+		result.first.node = new(placeholder(), small_nodes() + m_nsmall) unordered_hash_node<Key, Value>(p.first, p.second);
+		small_link(m_nsmall++);
+
+		result.second = true;
+		return result;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline pair<typename small_unordered_map<Key, Value, N, Alloc>::iterator, bool> small_unordered_map<Key, Value, N, Alloc>::insert(pair<Key, Value>&& p) {
+		if (!m_large.empty())
+			return m_large.insert(static_cast<pair<Key, Value>&&>(p));
+
+		pair<iterator, bool> result;
+		result.second = false;
+
+		result.first.node = small_find(p.first);
+		if (result.first.node != 0)
+			return result;
+
+		if (m_nsmall == N) {
+			spill();
+			return m_large.insert(static_cast<pair<Key, Value>&&>(p));
+		}
+
+		result.first.node = new(placeholder(), small_nodes() + m_nsmall) unordered_hash_node<Key, Value>(static_cast<Key&&>(p.first), static_cast<Value&&>(p.second));
+		small_link(m_nsmall++);
+
+		result.second = true;
+		return result;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline pair<typename small_unordered_map<Key, Value, N, Alloc>::iterator, bool> small_unordered_map<Key, Value, N, Alloc>::emplace(pair<Key, Value>&& p) {
+		return insert(static_cast<pair<Key, Value>&&>(p));
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::erase(const_iterator where) {
+		if (m_nsmall == 0)
+			m_large.erase(where);
+		else
+			small_erase(const_cast<pointer>(where.node));
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::erase(const Key& key) {
+		const_iterator where = find(key);
+		if (where != end())
+			erase(where);
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline Value& small_unordered_map<Key, Value, N, Alloc>::operator[](const Key& key) {
+		return insert(pair<Key, Value>(key, Value())).first->second;
+	}
+
+	template<typename Key, typename Value, size_t N, typename Alloc>
+	inline void small_unordered_map<Key, Value, N, Alloc>::swap(small_unordered_map& other) {
+		small_unordered_map temp;
+		temp.small_move(other);
+		other.small_move(*this);
+		small_move(temp);
+
+		m_large.swap(other.m_large);
+	}
+}
+#endif
@@ -33,6 +33,8 @@
 #include <TINYSTL/buffer.h>
 #include <TINYSTL/stddef.h>
 #include <TINYSTL/hash.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
 
 namespace tinystl {
 
@@ -42,7 +44,29 @@ namespace tinystl {
 	template<typename T>
 	inline constexpr T max(const T& a, const T& b) { return a > b ? a : b; }
 
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	// the flag byte of a heap string is the low byte of its capacity word
+	static inline size_t string_pack_capacity(size_t capacity) { return (capacity << 8) | 0x80; }
+	static inline size_t string_unpack_capacity(size_t packed) { return packed >> 8; }
+#else
+	// the flag byte of a heap string is the high byte of its capacity word
+	static inline size_t string_pack_capacity(size_t capacity) { return capacity | ((size_t)0x80 << (8 * (sizeof(size_t) - 1))); }
+	static inline size_t string_unpack_capacity(size_t packed) { return packed & ~((size_t)0x80 << (8 * (sizeof(size_t) - 1))); }
+#endif
+
+	// allocator of fixed_string: storage is never allocated
+	struct string_fixed_allocator {
+		static void* static_allocate(size_t /*bytes*/) { return nullptr; }
+		static void static_deallocate(void* /*ptr*/, size_t /*bytes*/) {}
+	};
+
 	template<typename Alloc>
+	struct string_is_fixed { static const bool value = false; };
+
+	template<>
+	struct string_is_fixed<string_fixed_allocator> { static const bool value = true; };
+
+	template<typename Alloc, size_t N = 0>
 	class basic_string {
 	public:
 		basic_string();
@@ -54,6 +78,7 @@ namespace tinystl {
 		basic_string(size_t len, char c);
 		basic_string(const char* first, const char* last);
 		basic_string(std::initializer_list<char> list);
+		explicit basic_string(string_view v);
 		~basic_string();
 
 		basic_string& operator=(const basic_string& other);
@@ -99,17 +124,17 @@ namespace tinystl {
 		const_iterator end() const;
 
 		void append(const char* first, const char* last);
-		void append(const basic_string& other);
+		void append(string_view other);
 		void assign(const char* first, const char* last);
 		void assign(const char* s, size_t n);
 		void insert(size_t where, char c);
 		void insert(size_t where, const char* first, const char* last);
-		void insert(size_t where, const basic_string& other);
+		void insert(size_t where, string_view other);
 		void insert(iterator where, char c);
 		void insert(iterator where, const char* first, const char* last);
-		void insert(iterator where, const basic_string& other);
+		void insert(iterator where, string_view other);
 
-		basic_string& operator+=(const basic_string& other);
+		basic_string& operator+=(string_view other);
 
 		void erase(size_t pos = 0, size_t len = npos);
 		iterator erase(iterator where);
@@ -117,487 +142,662 @@ namespace tinystl {
 
 		basic_string substr(size_t begin, size_t count = npos) const;
 
+		string_view view() const;
+		string_view substr_view(size_t begin, size_t count = npos) const;
+		operator string_view() const;
+
 		size_t find(char c, const size_t offset = 0) const;
 		size_t rfind(char c, const size_t offset = npos) const;
-		size_t find(const basic_string& other, const size_t offset = 0) const;
-		size_t rfind(const basic_string& other, const size_t offset = npos) const;
+		size_t find(string_view other, const size_t offset = 0) const;
+		size_t rfind(string_view other, const size_t offset = npos) const;
 
 		int compare(const basic_string& other) const;
+		int compare(const char* s) const;
+		int compare(string_view v) const;
+
+		bool starts_with(string_view v) const;
+		bool starts_with(char c) const;
+		bool ends_with(string_view v) const;
+		bool ends_with(char c) const;
+		bool contains(string_view v) const;
+		bool contains(char c) const;
+
+		// true once a fixed_string dropped characters that did not fit,
+		// until it is cleared or assigned
+		bool truncated() const;
 
 		static constexpr auto npos{ static_cast<size_t>(-1) };
 
 	protected:
-		static const size_t c_nbuffer = 12;
-		char m_small[12];
-
-		buffer<char, Alloc> m_buffer;
+		struct heap_storage {
+			char* first;
+			size_t size;
+			size_t capacity;
+		};
+
+		// Up to c_nbuffer characters are stored inline. The last byte holds
+		// c_nbuffer - size, which doubles as the null terminator of a full
+		// inline string. Heap strings set its high bit instead. The inline
+		// buffer holds at least N characters and fills any padding.
+		// A fixed string is never full up to the last byte, so that byte is
+		// never the terminator and its high bit records truncation instead.
+		static const bool c_fixed = string_is_fixed<Alloc>::value;
+		static const size_t c_nbuffer = ((max(N + 1 + c_fixed, sizeof(heap_storage)) + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1)) - 1;
+		static const size_t c_ninline = c_nbuffer - c_fixed;
+		static_assert(c_nbuffer < 128, "inline capacity must fit in the flag byte");
+
+		bool is_small() const;
+		void set_truncated(bool truncated);
+		void set_size(size_t size);
+		void set_heap(char* first, size_t size, size_t capacity);
+		void reallocate(size_t capacity);
+		void splice_grow(size_t pos, size_t len, const char* first, const char* last);
+		void splice(size_t pos, size_t len, const char* first, const char* last);
+
+		union {
+			heap_storage m_heap;
+			char m_small[c_nbuffer + 1];
+		};
 	};
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string()
-		: m_buffer{ m_small, m_small, m_small + c_nbuffer }
-	{}
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string() {
+		m_small[0] = 0;
+		m_small[c_nbuffer] = (char)c_nbuffer;
+	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string(const basic_string& other)
-		: basic_string()
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(const basic_string& other)
+		: basic_string(other.data(), other.size())
 	{
-		string_reserve(m_buffer, m_small, other.size());
-		string_copy(m_buffer, other.m_buffer.first, other.m_buffer.last);
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string(basic_string&& other)
-		: basic_string()
-	{
-		if(other.m_buffer.first == other.m_small)
-			string_copy(m_buffer, other.m_buffer.first, other.m_buffer.last);
-		else
-			m_buffer = other.m_buffer;
-		string_reset(other.m_buffer, other.m_small, c_nbuffer);
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(basic_string&& other) {
+		// both forms are moved as the same few words, without looking at which one it is
+		string_copy(m_small, other.m_small, c_nbuffer + 1);
+		other.m_small[0] = 0;
+		other.m_small[c_nbuffer] = (char)c_nbuffer;
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string(const char* s)
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(const char* s)
 		: basic_string()
 	{
-		size_t len = 0;
-		for(const char* it = s; *it; ++it)
-			++len;
-
-		string_reserve(m_buffer, m_small, len);
-		string_copy(m_buffer, s, s + len);
+		splice(0, 0, s, s + string_length(s));
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string(const char* s, size_t len)
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(const char* s, size_t len)
 		: basic_string()
 	{
-		string_reserve(m_buffer, m_small, len);
-		string_copy(m_buffer, s, s + len);
+		splice(0, 0, s, s + len);
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string(size_t len, char c)
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(size_t len, char c)
 		: basic_string()
 	{
-		string_reserve(m_buffer, m_small, len);
-		buffer_fill_urange(m_buffer.first, m_buffer.last, c);
+		resize(len, c);
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string(const char* first, const char* last) 
-		: basic_string()
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(const char* first, const char* last)
+		: basic_string(first, (size_t)(last - first))
 	{
-		string_reserve(m_buffer, m_small, last - first);
-		string_copy(m_buffer, first, last);
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::basic_string(std::initializer_list<char> list) 
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(std::initializer_list<char> list) 
 		: basic_string(list.begin(), list.end())
 	{
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>::~basic_string() {
-		if(m_buffer.first != m_small)
-			Alloc::static_deallocate(m_buffer.first, m_buffer.capacity - m_buffer.first);
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::basic_string(string_view v)
+		: basic_string(v.data(), v.size())
+	{
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>& basic_string<Alloc>::operator=(const basic_string& other) {
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::~basic_string() {
+		if(!is_small())
+			Alloc::static_deallocate(m_heap.first, string_unpack_capacity(m_heap.capacity) + 1);
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>& basic_string<Alloc, N>::operator=(const basic_string& other) {
 		basic_string(other).swap(*this);
 		return *this;
 	}
 
-	template<typename Alloc>
-	basic_string<Alloc>& basic_string<Alloc>::operator=(basic_string&& other) {
-		basic_string(static_cast<basic_string&&>(other)).swap(*this);
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>& basic_string<Alloc, N>::operator=(basic_string&& other) {
+		if(this != &other) {
+			if(!is_small())
+				Alloc::static_deallocate(m_heap.first, string_unpack_capacity(m_heap.capacity) + 1);
+
+			string_copy(m_small, other.m_small, c_nbuffer + 1);
+			other.m_small[0] = 0;
+			other.m_small[c_nbuffer] = (char)c_nbuffer;
+		}
 		return *this;
 	}
 
-	template<typename Alloc>
-	inline const char* basic_string<Alloc>::data() const {
-		return m_buffer.first;
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::is_small() const {
+		return c_fixed || ((unsigned char)m_small[c_nbuffer] & 0x80) == 0;
 	}
 
-	template<typename Alloc>
-	inline char* basic_string<Alloc>::data() {
-		return m_buffer.first;
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::set_truncated(bool truncated) {
+		if(c_fixed)
+			m_small[c_nbuffer] = (char)(((unsigned char)m_small[c_nbuffer] & 0x7f) | (truncated ? 0x80 : 0));
 	}
 
-	template<typename Alloc>
-	inline const char* basic_string<Alloc>::c_str() const {
-		return m_buffer.first;
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::truncated() const {
+		return c_fixed && ((unsigned char)m_small[c_nbuffer] & 0x80) != 0;
 	}
 
-	template<typename Alloc>
-	inline size_t basic_string<Alloc>::size() const {
-		return (size_t)(m_buffer.last - m_buffer.first);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::set_size(size_t size) {
+		if(is_small()) {
+			// an inline size never exceeds c_nbuffer; the clamp lets the compiler see it
+			size = size < c_nbuffer ? size : c_nbuffer;
+			m_small[c_nbuffer] = (char)((c_nbuffer - size) | (truncated() ? 0x80 : 0));
+			m_small[size] = 0;
+		} else {
+			m_heap.size = size;
+			m_heap.first[size] = 0;
+		}
 	}
 
-	template<typename Alloc>
-	inline size_t basic_string<Alloc>::capacity() const {
-		return (size_t)(m_buffer.capacity - m_buffer.first);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::set_heap(char* first, size_t size, size_t capacity) {
+		m_heap.first = first;
+		m_heap.size = size;
+		m_heap.capacity = string_pack_capacity(capacity);
+		if(c_nbuffer >= sizeof(heap_storage))
+			m_small[c_nbuffer] = (char)0x80;
+		first[size] = 0;
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::reallocate(size_t capacity) {
+		const size_t size = this->size();
+		char* first = (char*)Alloc::static_allocate(capacity + 1);
+		string_copy(first, data(), size);
+		if(!is_small())
+			Alloc::static_deallocate(m_heap.first, string_unpack_capacity(m_heap.capacity) + 1);
+
+		set_heap(first, size, capacity);
+	}
+
+	// the rare path of splice that moves to a bigger heap buffer
+	template<typename Alloc, size_t N>
+	TINYSTL_NOINLINE inline void basic_string<Alloc, N>::splice_grow(size_t pos, size_t len, const char* first, const char* last) {
+		const size_t size = this->size();
+		const size_t count = (size_t)(last - first);
+		const size_t newsize = size - len + count;
+		const char* const str = data();
+
+		const size_t newcapacity = (newsize * 3) / 2;
+		char* newstr = (char*)Alloc::static_allocate(newcapacity + 1);
+		string_copy(newstr, str, pos);
+		string_copy(newstr + pos, first, count);
+		string_copy(newstr + pos + count, str + pos + len, size - pos - len);
+		if(!is_small())
+			Alloc::static_deallocate(m_heap.first, string_unpack_capacity(m_heap.capacity) + 1);
+
+		set_heap(newstr, newsize, newcapacity);
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::splice(size_t pos, size_t len, const char* first, const char* last) {
+		const size_t size = this->size();
+		size_t count = (size_t)(last - first);
+		const size_t newsize = size - len + count;
+		const size_t capacity = this->capacity();
+		char* const str = data();
+
+		if(newsize > capacity && !c_fixed) {
+			splice_grow(pos, len, first, last);
+			return;
+		}
+
+		// the source aliases our own characters, which are about to move
+		if(count && first < str + size && last > str) {
+			const basic_string temp(first, last);
+			splice(pos, len, temp.data(), temp.data() + count);
+			return;
+		}
+
+		// a fixed string drops whatever no longer fits
+		const size_t fitted = min(count, capacity - pos);
+		const size_t tail = min(size - pos - len, capacity - pos - fitted);
+		if(pos + fitted + tail != newsize)
+			set_truncated(true);
+		count = fitted;
+
+		if(count != len)
+			string_move(str + pos + count, str + pos + len, tail);
+
+		string_copy(str + pos, first, count);
+		set_size(pos + count + tail);
 	}
 
-	template<typename Alloc>
-	inline bool basic_string<Alloc>::empty() const {
-		return m_buffer.last == m_buffer.first;
+	template<typename Alloc, size_t N>
+	inline const char* basic_string<Alloc, N>::data() const {
+		return is_small() ? m_small : m_heap.first;
 	}
 
-	template<typename Alloc>
-	inline char& basic_string<Alloc>::operator[](size_t idx) {
-		return m_buffer.first[idx];
+	template<typename Alloc, size_t N>
+	inline char* basic_string<Alloc, N>::data() {
+		return is_small() ? m_small : m_heap.first;
 	}
 
-	template<typename Alloc>
-	inline const char& basic_string<Alloc>::operator[](size_t idx) const {
-		return m_buffer.first[idx];
+	template<typename Alloc, size_t N>
+	inline const char* basic_string<Alloc, N>::c_str() const {
+		return data();
 	}
 
-	template<typename Alloc>
-	inline const char& basic_string<Alloc>::front() const {
-		return m_buffer.first[0];
+	template<typename Alloc, size_t N>
+	inline size_t basic_string<Alloc, N>::size() const {
+		return is_small() ? c_nbuffer - ((unsigned char)m_small[c_nbuffer] & 0x7f) : m_heap.size;
 	}
 
-	template<typename Alloc>
-	inline char& basic_string<Alloc>::front() {
-		return m_buffer.first[0];
+	template<typename Alloc, size_t N>
+	inline size_t basic_string<Alloc, N>::capacity() const {
+		return is_small() ? c_ninline : string_unpack_capacity(m_heap.capacity);
 	}
 
-	template<typename Alloc>
-	inline const char& basic_string<Alloc>::back() const {
-		return m_buffer.last[-1];
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::empty() const {
+		return size() == 0;
 	}
 
-	template<typename Alloc>
-	inline char& basic_string<Alloc>::back() {
-		return m_buffer.last[-1];
+	template<typename Alloc, size_t N>
+	inline char& basic_string<Alloc, N>::operator[](size_t idx) {
+		return data()[idx];
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::resize(size_t size) {
-		string_resize(m_buffer, m_small, size);
+	template<typename Alloc, size_t N>
+	inline const char& basic_string<Alloc, N>::operator[](size_t idx) const {
+		return data()[idx];
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::resize(size_t size, char value) {
-		string_resize(m_buffer, m_small, size, value);
+	template<typename Alloc, size_t N>
+	inline const char& basic_string<Alloc, N>::front() const {
+		return data()[0];
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::clear() {
-		string_clear(m_buffer);
+	template<typename Alloc, size_t N>
+	inline char& basic_string<Alloc, N>::front() {
+		return data()[0];
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::reserve(size_t capacity) {
-		string_reserve(m_buffer, m_small, capacity);
+	template<typename Alloc, size_t N>
+	inline const char& basic_string<Alloc, N>::back() const {
+		return data()[size() - 1];
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::push_back(char c) {
-		buffer_grow_count(m_buffer, 1, 1, m_buffer.first == m_small);
-		*m_buffer.last++ = c;
-		*m_buffer.last = 0;
+	template<typename Alloc, size_t N>
+	inline char& basic_string<Alloc, N>::back() {
+		return data()[size() - 1];
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::pop_back() {
-		string_pop(m_buffer);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::resize(size_t size) {
+		resize(size, 0);
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::swap(basic_string& other) {
-		const pointer tfirst = m_buffer.first, tlast = m_buffer.last, tcapacity = m_buffer.capacity;
-		m_buffer.first = other.m_buffer.first, m_buffer.last = other.m_buffer.last, m_buffer.capacity = other.m_buffer.capacity;
-		other.m_buffer.first = tfirst, other.m_buffer.last = tlast, other.m_buffer.capacity = tcapacity;
-
-		char tbuffer[c_nbuffer];
-
-		if(m_buffer.first == other.m_small)
-			for(pointer it = other.m_small, end = m_buffer.last, out = tbuffer; it != end; ++it, ++out)
-				*out = *it;
-
-		if(other.m_buffer.first == m_small) {
-			string_reset(other.m_buffer, other.m_small, c_nbuffer, other.m_buffer.last - other.m_buffer.first);
-			for(pointer it = other.m_buffer.first, end = other.m_buffer.last, in = m_small; it != end; ++it, ++in)
-				*it = *in;
-			*other.m_buffer.last = 0;
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::resize(size_t size, char value) {
+		if(c_fixed && size > c_ninline) {
+			size = c_ninline;
+			set_truncated(true);
 		}
 
-		if(m_buffer.first == other.m_small) {
-			string_reset(m_buffer, m_small, c_nbuffer, m_buffer.last - m_buffer.first);
-			for(pointer it = m_buffer.first, end = m_buffer.last, in = tbuffer; it != end; ++it, ++in)
-				*it = *in;
-			*m_buffer.last = 0;
+		const size_t oldsize = this->size();
+		reserve(size);
+		if(size > oldsize)
+			buffer_fill_urange(data() + oldsize, data() + size, value);
+		set_size(size);
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::clear() {
+		set_size(0);
+		set_truncated(false);
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::reserve(size_t capacity) {
+		if(capacity > this->capacity() && !c_fixed)
+			reallocate(capacity);
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::push_back(char c) {
+		const size_t size = this->size();
+		if(size == capacity()) {
+			if(c_fixed) {
+				set_truncated(true);
+				return;
+			}
+			reallocate(((size + 1) * 3) / 2);
 		}
+
+		data()[size] = c;
+		set_size(size + 1);
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::shrink_to_fit() {
-		if(m_buffer.first != m_small)
-			buffer_shrink_to_fit(m_buffer, 1);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::pop_back() {
+		set_size(size() - 1);
 	}
 
-	template<typename Alloc>
-	inline typename basic_string<Alloc>::iterator basic_string<Alloc>::begin() {
-		return m_buffer.first;
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::swap(basic_string& other) {
+		char temp[c_nbuffer + 1];
+		string_copy(temp, m_small, c_nbuffer + 1);
+		string_copy(m_small, other.m_small, c_nbuffer + 1);
+		string_copy(other.m_small, temp, c_nbuffer + 1);
 	}
 
-	template<typename Alloc>
-	inline typename basic_string<Alloc>::iterator basic_string<Alloc>::end() {
-		return m_buffer.last;
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::shrink_to_fit() {
+		if(is_small())
+			return;
+
+		const size_t size = m_heap.size;
+		const size_t capacity = string_unpack_capacity(m_heap.capacity);
+		if(size <= c_ninline) {
+			char* first = m_heap.first;
+			string_copy(m_small, first, size);
+			m_small[c_nbuffer] = (char)(c_nbuffer - size);
+			m_small[size] = 0;
+			Alloc::static_deallocate(first, capacity + 1);
+		} else if(size != capacity) {
+			reallocate(size);
+		}
 	}
 
-	template<typename Alloc>
-	inline typename basic_string<Alloc>::const_iterator basic_string<Alloc>::begin() const {
-		return m_buffer.first;
+	template<typename Alloc, size_t N>
+	inline typename basic_string<Alloc, N>::iterator basic_string<Alloc, N>::begin() {
+		return data();
 	}
 
-	template<typename Alloc>
-	inline typename basic_string<Alloc>::const_iterator basic_string<Alloc>::end() const {
-		return m_buffer.last;
+	template<typename Alloc, size_t N>
+	inline typename basic_string<Alloc, N>::iterator basic_string<Alloc, N>::end() {
+		return data() + size();
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::append(const char* first, const char* last) {
-		string_append(m_buffer, m_small, first, last);
+	template<typename Alloc, size_t N>
+	inline typename basic_string<Alloc, N>::const_iterator basic_string<Alloc, N>::begin() const {
+		return data();
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::append(const basic_string& other) {
-		string_append(m_buffer, m_small, other.begin(), other.end());
+	template<typename Alloc, size_t N>
+	inline typename basic_string<Alloc, N>::const_iterator basic_string<Alloc, N>::end() const {
+		return data() + size();
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::assign(const char* first, const char* last) {
-		string_clear(m_buffer);
-		string_append(m_buffer, m_small, first, last);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::append(const char* first, const char* last) {
+		splice(size(), 0, first, last);
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::assign(const char* sz, size_t n) {
-		string_clear(m_buffer);
-		string_append(m_buffer, m_small, sz, sz + n);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::append(string_view other) {
+		splice(size(), 0, other.begin(), other.end());
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::insert(size_t where, char value) {
-		string_insert(m_buffer, m_small, m_buffer.first + where, value);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::assign(const char* first, const char* last) {
+		set_truncated(false);
+		splice(0, size(), first, last);
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::insert(size_t where, const char* first, const char* last) {
-		string_insert(m_buffer, m_small, m_buffer.first + where, first, last);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::assign(const char* sz, size_t n) {
+		set_truncated(false);
+		splice(0, size(), sz, sz + n);
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::insert(size_t where, const basic_string& other) {
-		string_insert(m_buffer, m_small, m_buffer.first + where, other.begin(), other.end());
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::insert(size_t where, char value) {
+		splice(where, 0, &value, &value + 1);
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::insert(iterator where, char value) {
-		string_insert(m_buffer, m_small, where, value);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::insert(size_t where, const char* first, const char* last) {
+		splice(where, 0, first, last);
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::insert(iterator where, const char* first, const char* last) {
-		string_insert(m_buffer, m_small, where, first, last);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::insert(size_t where, string_view other) {
+		splice(where, 0, other.begin(), other.end());
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::insert(iterator where, const basic_string& other) {
-		string_insert(m_buffer, m_small, where, other.begin(), other.end());
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::insert(iterator where, char value) {
+		splice((size_t)(where - begin()), 0, &value, &value + 1);
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc>& basic_string<Alloc>::operator+=(const basic_string& other) {
-		string_append(m_buffer, m_small, other.begin(), other.end());
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::insert(iterator where, const char* first, const char* last) {
+		splice((size_t)(where - begin()), 0, first, last);
+	}
+
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::insert(iterator where, string_view other) {
+		splice((size_t)(where - begin()), 0, other.begin(), other.end());
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>& basic_string<Alloc, N>::operator+=(string_view other) {
+		splice(size(), 0, other.begin(), other.end());
 		return *this;
 	}
 
-	template<typename Alloc>
-	inline void basic_string<Alloc>::erase(size_t pos, size_t len) {
-		string_erase(m_buffer, m_buffer.first + pos, len == npos ? m_buffer.last : m_buffer.first + pos + len);
+	template<typename Alloc, size_t N>
+	inline void basic_string<Alloc, N>::erase(size_t pos, size_t len) {
+		const size_t count = (len > size() - pos) ? size() - pos : len;
+		splice(pos, count, 0, 0);
 	}
 
-	template<typename Alloc>
-	inline typename basic_string<Alloc>::iterator basic_string<Alloc>::erase(iterator where) {
-		return string_erase(m_buffer, where, where + 1);
+	template<typename Alloc, size_t N>
+	inline typename basic_string<Alloc, N>::iterator basic_string<Alloc, N>::erase(iterator where) {
+		const size_t pos = (size_t)(where - begin());
+		splice(pos, 1, 0, 0);
+		return begin() + pos;
 	}
 
-	template<typename Alloc>
-	inline typename basic_string<Alloc>::iterator basic_string<Alloc>::erase(iterator first, iterator last) {
-		return string_erase(m_buffer, first, last);
+	template<typename Alloc, size_t N>
+	inline typename basic_string<Alloc, N>::iterator basic_string<Alloc, N>::erase(iterator first, iterator last) {
+		const size_t pos = (size_t)(first - begin());
+		splice(pos, (size_t)(last - first), 0, 0);
+		return begin() + pos;
 	}
 
-	template<typename Alloc>
-	inline basic_string<Alloc> basic_string<Alloc>::substr(size_t begin, size_t count) const {
-		return basic_string(m_buffer.first + begin, min(count, this->size() - begin));
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N> basic_string<Alloc, N>::substr(size_t begin, size_t count) const {
+		return basic_string(data() + begin, min(count, this->size() - begin));
 	}
 
-	template<typename Alloc>
-	inline int basic_string<Alloc>::compare(const basic_string& other) const {
-		pointer first1 = m_buffer.first;
-		pointer first2 = other.m_buffer.first;
-		const pointer last1 = m_buffer.last;
-		const pointer last2 = other.m_buffer.last;
-
-		const size_t count1 = size_t(last1 - first1);
-		const size_t count2 = size_t(last2 - first2);
-		size_t count = count1 < count2 ? count1 : count2;
-
-		for(; 0 < count; --count, ++first1, ++first2)
-			if(*first1 != *first2)
-			{
-				return (*first1 < *first2 ? -1 : +1);
-			}
+	template<typename Alloc, size_t N>
+	inline string_view basic_string<Alloc, N>::view() const {
+		return string_view(data(), size());
+	}
+
+	template<typename Alloc, size_t N>
+	inline string_view basic_string<Alloc, N>::substr_view(size_t begin, size_t count) const {
+		return string_view(data() + begin, min(count, this->size() - begin));
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_string<Alloc, N>::operator string_view() const {
+		return string_view(data(), size());
+	}
+
+	template<typename Alloc, size_t N>
+	inline int basic_string<Alloc, N>::compare(const basic_string& other) const {
+		return compare(string_view(other.data(), other.size()));
+	}
+
+	template<typename Alloc, size_t N>
+	inline int basic_string<Alloc, N>::compare(const char* s) const {
+		return compare(string_view(s, string_length(s)));
+	}
+
+	template<typename Alloc, size_t N>
+	inline int basic_string<Alloc, N>::compare(string_view v) const {
+		const size_t count1 = size();
+		const size_t count2 = v.size();
+
+		const int result = string_compare(data(), v.data(), count1 < count2 ? count1 : count2);
+		if(result != 0) return result;
 
 		if(count1 < count2) return -1;
 		if(count1 > count2) return 1;
 		return 0;
 	}
 
-	inline int string_compare(const char* first1, const char* first2, size_t count)
-	{
-		for(; 0 < count; --count, ++first1, ++first2)
-			if(*first1 != *first2)
-			{
-				return *first1 < *first2 ? -1 : 1;
-			}
-		return 0;
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::starts_with(string_view v) const {
+		return v.size() <= size() && string_equal(data(), v.data(), v.size());
 	}
 
-	inline const char* string_find(const char* first, size_t count, const char& c)
-	{
-		for(; 0 < count; --count, ++first)
-			if(*first == c)
-			{
-				return first;
-			}
-		return nullptr;
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::starts_with(char c) const {
+		return !empty() && front() == c;
 	}
 
-	template<typename Alloc>
-	inline size_t basic_string<Alloc>::find(char c, const size_t offset) const {
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::ends_with(string_view v) const {
+		const size_t size = this->size();
+		return v.size() <= size && string_equal(data() + size - v.size(), v.data(), v.size());
+	}
+
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::ends_with(char c) const {
+		return !empty() && back() == c;
+	}
+
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::contains(string_view v) const {
+		return string_search(data(), size(), v.data(), v.size()) != nullptr;
+	}
+
+	template<typename Alloc, size_t N>
+	inline bool basic_string<Alloc, N>::contains(char c) const {
+		return string_find(data(), size(), c) != nullptr;
+	}
+
+	template<typename Alloc, size_t N>
+	inline size_t basic_string<Alloc, N>::find(char c, const size_t offset) const {
 		const size_t hay_size = size();
-		const char* hay = m_buffer.first;
+		const char* hay = data();
 		if(offset < hay_size)
 		{
 			const char* match = string_find(hay + offset, hay_size - offset, c);
 			if(match)
-				return size_t(match - m_buffer.first);
+				return size_t(match - hay);
 		}
 
 		return size_t(-1);
 	}
 
-	template<typename Alloc>
-	inline size_t basic_string<Alloc>::rfind(char c, const size_t offset) const {
+	template<typename Alloc, size_t N>
+	inline size_t basic_string<Alloc, N>::rfind(char c, const size_t offset) const {
 		const size_t hay_size = size();
-		const char* hay = m_buffer.first;
-		if(hay_size != 0)
-			for(const char* current = hay + min(offset, hay_size - 1); current != hay; --current)
-			{
-				if(*current == c)
-					return size_t(current - hay);
-			}
+		const char* hay = data();
+		if(hay_size == 0)
+			return size_t(-1);
 
-		return size_t(-1);
+		const char* match = string_rfind(hay, min(offset, hay_size - 1) + 1, c);
+		return match ? size_t(match - hay) : size_t(-1);
 	}
 
-	template<typename Alloc>
-	inline size_t basic_string<Alloc>::find(const basic_string& other, const size_t offset) const {
-		const char* hay = this->begin();
-		const char* needle = other.begin();
+	template<typename Alloc, size_t N>
+	inline size_t basic_string<Alloc, N>::find(string_view other, const size_t offset) const {
+		const char* hay = data();
 		const size_t hay_size = size();
-		const size_t needle_size = other.size();
-
-		if(needle_size > hay_size || offset > hay_size - needle_size)
+		if(offset > hay_size)
 			return size_t(-1);
-		if(needle_size == 0)
-			return offset;
 
-		const char* last_possible = hay + (hay_size - needle_size) + 1;
-		for(const char* current = hay + offset; ; ++current)
-		{
-			current = string_find(current, size_t(last_possible - current), *needle);
-			if(!current)
-				return size_t(-1);
-			if(string_compare(current, needle, needle_size) == 0)
-				return size_t(current - hay);
-		}
+		const char* match = string_search(hay + offset, hay_size - offset, other.data(), other.size());
+		return match ? size_t(match - hay) : size_t(-1);
 	}
 
-	template<typename Alloc>
-	inline size_t basic_string<Alloc>::rfind(const basic_string& other, const size_t offset) const {
-		const char* hay = this->begin();
-		const char* needle = other.begin();
-		const size_t hay_size = this->size();
+	template<typename Alloc, size_t N>
+	inline size_t basic_string<Alloc, N>::rfind(string_view other, const size_t offset) const {
+		const char* hay = data();
+		const size_t hay_size = size();
 		const size_t needle_size = other.size();
+		if(needle_size > hay_size)
+			return size_t(-1);
 
-		if(needle_size == 0)
-			return min(offset, hay_size);
-
-		if(needle_size <= hay_size)
-			for(const char* current = hay + min(offset, hay_size - needle_size); current != hay; --current)
-			{
-				if(*current == *needle && string_compare(current, needle, needle_size) == 0)
-				{
-					return size_t(current - hay);
-				}
-			}
-
-		return size_t(-1);
+		const size_t last_possible = min(offset, hay_size - needle_size);
+		const char* match = string_rsearch(hay, last_possible + needle_size, other.data(), needle_size);
+		return match ? size_t(match - hay) : size_t(-1);
 	}
 
-	template<typename LAlloc, typename RAlloc>
-	inline bool operator==(const basic_string<LAlloc>& lhs, const basic_string<RAlloc>& rhs) {
-		typedef const char* pointer;
+	template<typename LAlloc, size_t LN, typename RAlloc, size_t RN>
+	inline bool operator==(const basic_string<LAlloc, LN>& lhs, const basic_string<RAlloc, RN>& rhs) {
+		const size_t lsize = lhs.size();
+		return lsize == rhs.size() && string_equal(lhs.c_str(), rhs.c_str(), lsize);
+	}
 
-		const size_t lsize = lhs.size(), rsize = rhs.size();
-		if (lsize != rsize)
-			return false;
+	template<typename LAlloc, size_t LN, typename RAlloc, size_t RN>
+	inline bool operator<(const basic_string<LAlloc, LN>& lhs, const basic_string<RAlloc, RN>& rhs) {
+		return lhs.compare(rhs) < 0;
+	}
 
-		pointer lit = lhs.c_str(), rit = rhs.c_str();
-		pointer lend = lit + lsize;
-		while (lit != lend)
-			if (*lit++ != *rit++)
-				return false;
+	template<typename LAlloc, size_t LN, typename RAlloc, size_t RN>
+	inline bool operator!=(const basic_string<LAlloc, LN>& lhs, const basic_string<RAlloc, RN>& rhs) { return !(lhs == rhs); }
 
-		return true;
+	template<typename Alloc, size_t N>
+	inline bool operator==(const basic_string<Alloc, N>& lhs, string_view rhs) {
+		const size_t lsize = lhs.size();
+		return lsize == rhs.size() && string_equal(lhs.c_str(), rhs.data(), lsize);
 	}
 
-	template<typename LAlloc, typename RAlloc>
-	inline bool operator<(const basic_string<LAlloc>& lhs, const basic_string<RAlloc>& rhs) {
-		return lhs.compare(rhs) < 0;
-	}
+	template<typename Alloc, size_t N>
+	inline bool operator==(string_view lhs, const basic_string<Alloc, N>& rhs) { return rhs == lhs; }
 
-	template<typename LAlloc, typename RAlloc>
-	inline bool operator!=(const basic_string<LAlloc>& lhs, const basic_string<RAlloc>& rhs) { return !(lhs == rhs); }
+	template<typename Alloc, size_t N>
+	inline bool operator!=(const basic_string<Alloc, N>& lhs, string_view rhs) { return !(lhs == rhs); }
 
-	template<typename Alloc>
-	inline bool operator==(const basic_string<Alloc>& lhs, const char* rhs) { return lhs == basic_string<Alloc>(rhs); }
+	template<typename Alloc, size_t N>
+	inline bool operator!=(string_view lhs, const basic_string<Alloc, N>& rhs) { return !(rhs == lhs); }
 
-	template<typename Alloc>
-	inline bool operator==(const char* lhs, const basic_string<Alloc>& rhs) { return basic_string<Alloc>(lhs) == rhs; }
+	template<typename Alloc, size_t N>
+	inline bool operator==(const basic_string<Alloc, N>& lhs, const char* rhs) { return lhs == string_view(rhs, string_length(rhs)); }
+
+	template<typename Alloc, size_t N>
+	inline bool operator==(const char* lhs, const basic_string<Alloc, N>& rhs) { return rhs == string_view(lhs, string_length(lhs)); }
 	
-	template<typename Alloc>
-	inline bool operator!=(const basic_string<Alloc>& lhs, const char* rhs) { return lhs != basic_string<Alloc>(rhs); }
+	template<typename Alloc, size_t N>
+	inline bool operator!=(const basic_string<Alloc, N>& lhs, const char* rhs) { return !(lhs == rhs); }
 
-	template<typename Alloc>
-	inline bool operator!=(const char* lhs, const basic_string<Alloc>& rhs) { return basic_string<Alloc>(lhs) != rhs; }
+	template<typename Alloc, size_t N>
+	inline bool operator!=(const char* lhs, const basic_string<Alloc, N>& rhs) { return !(rhs == lhs); }
 
-	template<typename Alloc>
-	static inline size_t hash(const basic_string<Alloc>& value) {
+	template<typename Alloc, size_t N>
+	static inline size_t hash(const basic_string<Alloc, N>& value) {
 		return hash_string(value.c_str(), value.size());
 	}
 
 	using string = basic_string<TINYSTL_ALLOCATOR>;
+
+	// A string that never allocates: it holds at least N characters inline.
+	// Characters that do not fit are dropped, and truncated() reports that
+	// this happened.
+	template<size_t N>
+	using fixed_string = basic_string<string_fixed_allocator, N>;
 }
 
 #endif
@@ -0,0 +1,554 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_BASE_H
+#define TINYSTL_STRING_BASE_H
+
+#include <TINYSTL/stddef.h>
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#	define TINYSTL_STRING_SIMD 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define TINYSTL_STRING_SIMD 16
+#endif
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+// string_length reads whole aligned blocks, possibly past the terminator
+#if defined(_MSC_VER)
+#	define TINYSTL_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#elif defined(__GNUC__)
+#	define TINYSTL_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#	define TINYSTL_NO_SANITIZE_ADDRESS
+#endif
+
+#if defined(_MSC_VER)
+#	define TINYSTL_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__)
+#	define TINYSTL_NOINLINE __attribute__((noinline))
+#else
+#	define TINYSTL_NOINLINE
+#endif
+
+#if defined(__has_builtin)
+#	if __has_builtin(__builtin_is_constant_evaluated)
+#		define TINYSTL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#	endif
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#	define TINYSTL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+// calls name##_scalar during constant evaluation and the block kernel otherwise
+#if defined(TINYSTL_IS_CONSTANT_EVALUATED)
+#	define TINYSTL_STRING_KERNEL(name, ...) (TINYSTL_IS_CONSTANT_EVALUATED() ? name##_scalar(__VA_ARGS__) : name(__VA_ARGS__))
+#else
+#	define TINYSTL_STRING_KERNEL(name, ...) name##_scalar(__VA_ARGS__)
+#endif
+
+namespace tinystl {
+
+	static inline unsigned string_ctz(unsigned mask) {
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return (unsigned)index;
+#else
+		return (unsigned)__builtin_ctz(mask);
+#endif
+	}
+
+	static inline unsigned string_highbit(unsigned mask) {
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, mask);
+		return (unsigned)index;
+#else
+		return 31 - (unsigned)__builtin_clz(mask);
+#endif
+	}
+
+#if TINYSTL_STRING_SIMD == 32
+	typedef __m256i string_simd;
+
+	static inline string_simd string_simd_splat(char c) {
+		return _mm256_set1_epi8(c);
+	}
+
+	// bit i is set when p[i] == c
+	static inline unsigned string_simd_match(const char* p, string_simd c) {
+		const __m256i block = _mm256_loadu_si256((const __m256i*)p);
+		return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, c));
+	}
+
+	TINYSTL_NO_SANITIZE_ADDRESS static inline unsigned string_simd_match_aligned(const char* p, string_simd c) {
+		const __m256i block = _mm256_load_si256((const __m256i*)p);
+		return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, c));
+	}
+
+	// bit i is set when a[i] == b[i]
+	static inline unsigned string_simd_equal(const char* a, const char* b) {
+		const __m256i lhs = _mm256_loadu_si256((const __m256i*)a);
+		const __m256i rhs = _mm256_loadu_si256((const __m256i*)b);
+		return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs));
+	}
+
+	static inline __m256i string_simd_tolower(const char* p) {
+		const __m256i block = _mm256_loadu_si256((const __m256i*)p);
+		const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+		return _mm256_or_si256(block, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+	}
+
+	// bit i is set when a[i] and b[i] are equal ignoring ascii case
+	static inline unsigned string_simd_iequal(const char* a, const char* b) {
+		return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(string_simd_tolower(a), string_simd_tolower(b)));
+	}
+
+	static inline void string_simd_store_tolower(char* out, const char* p) {
+		_mm256_storeu_si256((__m256i*)out, string_simd_tolower(p));
+	}
+
+	static const unsigned c_string_simd_all = 0xffffffffu;
+#elif TINYSTL_STRING_SIMD == 16
+	typedef __m128i string_simd;
+
+	static inline string_simd string_simd_splat(char c) {
+		return _mm_set1_epi8(c);
+	}
+
+	// bit i is set when p[i] == c
+	static inline unsigned string_simd_match(const char* p, string_simd c) {
+		const __m128i block = _mm_loadu_si128((const __m128i*)p);
+		return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, c));
+	}
+
+	TINYSTL_NO_SANITIZE_ADDRESS static inline unsigned string_simd_match_aligned(const char* p, string_simd c) {
+		const __m128i block = _mm_load_si128((const __m128i*)p);
+		return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, c));
+	}
+
+	// bit i is set when a[i] == b[i]
+	static inline unsigned string_simd_equal(const char* a, const char* b) {
+		const __m128i lhs = _mm_loadu_si128((const __m128i*)a);
+		const __m128i rhs = _mm_loadu_si128((const __m128i*)b);
+		return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs));
+	}
+
+	static inline __m128i string_simd_tolower(const char* p) {
+		const __m128i block = _mm_loadu_si128((const __m128i*)p);
+		const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), block));
+		return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+	}
+
+	// bit i is set when a[i] and b[i] are equal ignoring ascii case
+	static inline unsigned string_simd_iequal(const char* a, const char* b) {
+		return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(string_simd_tolower(a), string_simd_tolower(b)));
+	}
+
+	static inline void string_simd_store_tolower(char* out, const char* p) {
+		_mm_storeu_si128((__m128i*)out, string_simd_tolower(p));
+	}
+
+	static const unsigned c_string_simd_all = 0xffffu;
+#endif
+
+	// constexpr versions for string_view, used during constant evaluation
+
+	static constexpr size_t string_length_scalar(const char* s) {
+		size_t len = 0;
+		while(s[len])
+			++len;
+		return len;
+	}
+
+	static constexpr int string_compare_scalar(const char* first1, const char* first2, size_t count) {
+		for(; 0 < count; --count, ++first1, ++first2)
+			if(*first1 != *first2)
+				return *first1 < *first2 ? -1 : 1;
+		return 0;
+	}
+
+	static constexpr const char* string_find_scalar(const char* first, size_t count, char c) {
+		for(; 0 < count; --count, ++first)
+			if(*first == c)
+				return first;
+		return nullptr;
+	}
+
+	static constexpr const char* string_rfind_scalar(const char* first, size_t count, char c) {
+		while(count-- > 0)
+			if(first[count] == c)
+				return first + count;
+		return nullptr;
+	}
+
+	static constexpr bool string_equal_scalar(const char* first1, const char* first2, size_t count) {
+		return string_compare_scalar(first1, first2, count) == 0;
+	}
+
+	static constexpr char string_tolower_scalar(char c) {
+		return c >= 'A' && c <= 'Z' ? (char)(c | 0x20) : c;
+	}
+
+	static constexpr bool string_iequal_scalar(const char* first1, const char* first2, size_t count) {
+		for(; 0 < count; --count, ++first1, ++first2)
+			if(string_tolower_scalar(*first1) != string_tolower_scalar(*first2))
+				return false;
+		return true;
+	}
+
+	static constexpr const char* string_search_scalar(const char* hay, size_t hay_size, const char* needle, size_t needle_size) {
+		if(needle_size > hay_size)
+			return nullptr;
+		for(size_t pos = 0; pos <= hay_size - needle_size; ++pos)
+			if(string_compare_scalar(hay + pos, needle, needle_size) == 0)
+				return hay + pos;
+		return nullptr;
+	}
+
+	static constexpr const char* string_rsearch_scalar(const char* hay, size_t hay_size, const char* needle, size_t needle_size) {
+		if(needle_size > hay_size)
+			return nullptr;
+		for(size_t pos = hay_size - needle_size + 1; pos-- > 0; )
+			if(string_compare_scalar(hay + pos, needle, needle_size) == 0)
+				return hay + pos;
+		return nullptr;
+	}
+
+	static constexpr const char* string_find_first_of_scalar(const char* first, size_t count, const char* set, size_t set_size) {
+		for(; 0 < count; --count, ++first)
+			if(string_find_scalar(set, set_size, *first))
+				return first;
+		return nullptr;
+	}
+
+	static constexpr const char* string_find_last_of_scalar(const char* first, size_t count, const char* set, size_t set_size) {
+		while(count-- > 0)
+			if(string_find_scalar(set, set_size, first[count]))
+				return first + count;
+		return nullptr;
+	}
+
+	// copies count characters between non-overlapping ranges
+	static inline void string_copy(char* dest, const char* first, size_t count) {
+#if defined(__GNUC__)
+		if(count)
+			__builtin_memcpy(dest, first, count);
+#else
+		for(; 0 < count; --count, ++dest, ++first)
+			*dest = *first;
+#endif
+	}
+
+	// copies count characters between possibly overlapping ranges
+	static inline void string_move(char* dest, const char* first, size_t count) {
+#if defined(__GNUC__)
+		if(count)
+			__builtin_memmove(dest, first, count);
+#else
+		if(dest < first) {
+			for(; 0 < count; --count, ++dest, ++first)
+				*dest = *first;
+		} else {
+			while(count-- > 0)
+				dest[count] = first[count];
+		}
+#endif
+	}
+
+	TINYSTL_NO_SANITIZE_ADDRESS static inline size_t string_length(const char* s) {
+#if defined(TINYSTL_STRING_SIMD)
+		// aligned blocks never cross a page boundary, so reading past the terminator is safe
+		const string_simd zero = string_simd_splat(0);
+		const size_t misalign = (size_t)s & (TINYSTL_STRING_SIMD - 1);
+		const char* block = s - misalign;
+		unsigned mask = string_simd_match_aligned(block, zero) >> misalign;
+		if(mask)
+			return string_ctz(mask);
+
+		for(;;) {
+			block += TINYSTL_STRING_SIMD;
+			mask = string_simd_match_aligned(block, zero);
+			if(mask)
+				return (size_t)(block - s) + string_ctz(mask);
+		}
+#else
+		return string_length_scalar(s);
+#endif
+	}
+
+	static inline int string_compare(const char* first1, const char* first2, size_t count) {
+#if defined(TINYSTL_STRING_SIMD)
+		for(; count >= TINYSTL_STRING_SIMD; count -= TINYSTL_STRING_SIMD, first1 += TINYSTL_STRING_SIMD, first2 += TINYSTL_STRING_SIMD) {
+			const unsigned mask = string_simd_equal(first1, first2) ^ c_string_simd_all;
+			if(mask) {
+				const unsigned index = string_ctz(mask);
+				return first1[index] < first2[index] ? -1 : 1;
+			}
+		}
+#endif
+		return string_compare_scalar(first1, first2, count);
+	}
+
+	static inline bool string_equal(const char* first1, const char* first2, size_t count) {
+#if defined(TINYSTL_STRING_SIMD)
+		for(; count >= TINYSTL_STRING_SIMD; count -= TINYSTL_STRING_SIMD, first1 += TINYSTL_STRING_SIMD, first2 += TINYSTL_STRING_SIMD) {
+			if(string_simd_equal(first1, first2) != c_string_simd_all)
+				return false;
+		}
+#endif
+		for(; 0 < count; --count, ++first1, ++first2)
+			if(*first1 != *first2)
+				return false;
+		return true;
+	}
+
+	static inline bool string_iequal(const char* first1, const char* first2, size_t count) {
+#if defined(TINYSTL_STRING_SIMD)
+		for(; count >= TINYSTL_STRING_SIMD; count -= TINYSTL_STRING_SIMD, first1 += TINYSTL_STRING_SIMD, first2 += TINYSTL_STRING_SIMD) {
+			if(string_simd_iequal(first1, first2) != c_string_simd_all)
+				return false;
+		}
+#endif
+		return string_iequal_scalar(first1, first2, count);
+	}
+
+	static inline const char* string_find(const char* first, size_t count, char c) {
+#if defined(TINYSTL_STRING_SIMD)
+		const string_simd vc = string_simd_splat(c);
+		for(; count >= TINYSTL_STRING_SIMD; count -= TINYSTL_STRING_SIMD, first += TINYSTL_STRING_SIMD) {
+			const unsigned mask = string_simd_match(first, vc);
+			if(mask)
+				return first + string_ctz(mask);
+		}
+#endif
+		return string_find_scalar(first, count, c);
+	}
+
+	static inline const char* string_rfind(const char* first, size_t count, char c) {
+#if defined(TINYSTL_STRING_SIMD)
+		const string_simd vc = string_simd_splat(c);
+		for(; count >= TINYSTL_STRING_SIMD; count -= TINYSTL_STRING_SIMD) {
+			const unsigned mask = string_simd_match(first + count - TINYSTL_STRING_SIMD, vc);
+			if(mask)
+				return first + count - TINYSTL_STRING_SIMD + string_highbit(mask);
+		}
+#endif
+		return string_rfind_scalar(first, count, c);
+	}
+
+	// needles at least this long are searched with Horspool's skip table
+	static const size_t c_string_horspool_min = 32;
+
+	static inline const char* string_search_horspool(const char* hay, size_t hay_size, const char* needle, size_t needle_size) {
+		size_t skip[256];
+		for(size_t ii = 0; ii < 256; ++ii)
+			skip[ii] = needle_size;
+		for(size_t ii = 0; ii < needle_size - 1; ++ii)
+			skip[(unsigned char)needle[ii]] = needle_size - 1 - ii;
+
+		const char last = needle[needle_size - 1];
+		for(size_t pos = 0; pos <= hay_size - needle_size; ) {
+			const char c = hay[pos + needle_size - 1];
+			if(c == last && string_equal(hay + pos, needle, needle_size - 1))
+				return hay + pos;
+			pos += skip[(unsigned char)c];
+		}
+
+		return nullptr;
+	}
+
+	static inline const char* string_rsearch_horspool(const char* hay, size_t hay_size, const char* needle, size_t needle_size) {
+		size_t skip[256];
+		for(size_t ii = 0; ii < 256; ++ii)
+			skip[ii] = needle_size;
+		for(size_t ii = needle_size - 1; ii > 0; --ii)
+			skip[(unsigned char)needle[ii]] = ii;
+
+		const char first = needle[0];
+		for(size_t pos = hay_size - needle_size; ; ) {
+			const char c = hay[pos];
+			if(c == first && string_equal(hay + pos + 1, needle + 1, needle_size - 1))
+				return hay + pos;
+			if(pos < skip[(unsigned char)c])
+				return nullptr;
+			pos -= skip[(unsigned char)c];
+		}
+	}
+
+	// first occurrence of needle in hay, or nullptr
+	static inline const char* string_search(const char* hay, size_t hay_size, const char* needle, size_t needle_size) {
+		if(needle_size == 0)
+			return hay;
+		if(needle_size > hay_size)
+			return nullptr;
+		if(needle_size >= c_string_horspool_min)
+			return string_search_horspool(hay, hay_size, needle, needle_size);
+
+		const size_t last_possible = hay_size - needle_size;
+		const char first = needle[0];
+		const char last = needle[needle_size - 1];
+		// shorter than c_string_horspool_min, so the middle is compared a byte at a time
+		const size_t middle = needle_size > 1 ? needle_size - 2 : 0;
+		size_t pos = 0;
+
+#if defined(TINYSTL_STRING_SIMD)
+		// only test the middle of positions where both the first and last byte match
+		const string_simd vfirst = string_simd_splat(first);
+		const string_simd vlast = string_simd_splat(last);
+		for(; pos + TINYSTL_STRING_SIMD <= last_possible + 1; pos += TINYSTL_STRING_SIMD) {
+			unsigned mask = string_simd_match(hay + pos, vfirst) & string_simd_match(hay + pos + needle_size - 1, vlast);
+			for(; mask; mask &= mask - 1) {
+				const char* candidate = hay + pos + string_ctz(mask);
+				if(string_compare_scalar(candidate + 1, needle + 1, middle) == 0)
+					return candidate;
+			}
+		}
+#endif
+
+		for(; pos <= last_possible; ++pos) {
+			if(hay[pos] == first && hay[pos + needle_size - 1] == last && string_compare_scalar(hay + pos + 1, needle + 1, middle) == 0)
+				return hay + pos;
+		}
+
+		return nullptr;
+	}
+
+	// last occurrence of needle in hay, or nullptr
+	static inline const char* string_rsearch(const char* hay, size_t hay_size, const char* needle, size_t needle_size) {
+		if(needle_size == 0)
+			return hay + hay_size;
+		if(needle_size > hay_size)
+			return nullptr;
+		if(needle_size >= c_string_horspool_min)
+			return string_rsearch_horspool(hay, hay_size, needle, needle_size);
+
+		const char first = needle[0];
+		const char last = needle[needle_size - 1];
+		// shorter than c_string_horspool_min, so the middle is compared a byte at a time
+		const size_t middle = needle_size > 1 ? needle_size - 2 : 0;
+
+		// positions [0, end) remain to be tested
+		size_t end = hay_size - needle_size + 1;
+
+#if defined(TINYSTL_STRING_SIMD)
+		const string_simd vfirst = string_simd_splat(first);
+		const string_simd vlast = string_simd_splat(last);
+		for(; end >= TINYSTL_STRING_SIMD; end -= TINYSTL_STRING_SIMD) {
+			const char* block = hay + end - TINYSTL_STRING_SIMD;
+			unsigned mask = string_simd_match(block, vfirst) & string_simd_match(block + needle_size - 1, vlast);
+			while(mask) {
+				const unsigned bit = string_highbit(mask);
+				if(string_compare_scalar(block + bit + 1, needle + 1, middle) == 0)
+					return block + bit;
+				mask ^= 1u << bit;
+			}
+		}
+#endif
+
+		while(end-- > 0) {
+			if(hay[end] == first && hay[end + needle_size - 1] == last && string_compare_scalar(hay + end + 1, needle + 1, middle) == 0)
+				return hay + end;
+		}
+
+		return nullptr;
+	}
+
+#if defined(TINYSTL_STRING_SIMD)
+	// sets up to this size are matched a block at a time, larger ones through a table
+	static const size_t c_string_simd_set_max = 8;
+
+	// bit i is set when p[i] is one of the set_size characters splatted in set
+	static inline unsigned string_simd_match_set(const char* p, const string_simd* set, size_t set_size) {
+		unsigned mask = 0;
+		for(size_t ii = 0; ii < set_size; ++ii)
+			mask |= string_simd_match(p, set[ii]);
+		return mask;
+	}
+#endif
+
+	static inline const char* string_find_first_of(const char* first, size_t count, const char* set, size_t set_size) {
+		if(set_size == 1)
+			return string_find(first, count, set[0]);
+
+#if defined(TINYSTL_STRING_SIMD)
+		if(set_size <= c_string_simd_set_max) {
+			string_simd vset[c_string_simd_set_max];
+			for(size_t ii = 0; ii < set_size; ++ii)
+				vset[ii] = string_simd_splat(set[ii]);
+
+			for(; count >= TINYSTL_STRING_SIMD; count -= TINYSTL_STRING_SIMD, first += TINYSTL_STRING_SIMD) {
+				const unsigned mask = string_simd_match_set(first, vset, set_size);
+				if(mask)
+					return first + string_ctz(mask);
+			}
+			return string_find_first_of_scalar(first, count, set, set_size);
+		}
+#endif
+
+		bool table[256] = {};
+		for(size_t ii = 0; ii < set_size; ++ii)
+			table[(unsigned char)set[ii]] = true;
+		for(; 0 < count; --count, ++first)
+			if(table[(unsigned char)*first])
+				return first;
+		return nullptr;
+	}
+
+	static inline const char* string_find_last_of(const char* first, size_t count, const char* set, size_t set_size) {
+		if(set_size == 1)
+			return string_rfind(first, count, set[0]);
+
+#if defined(TINYSTL_STRING_SIMD)
+		if(set_size <= c_string_simd_set_max) {
+			string_simd vset[c_string_simd_set_max];
+			for(size_t ii = 0; ii < set_size; ++ii)
+				vset[ii] = string_simd_splat(set[ii]);
+
+			for(; count >= TINYSTL_STRING_SIMD; count -= TINYSTL_STRING_SIMD) {
+				const unsigned mask = string_simd_match_set(first + count - TINYSTL_STRING_SIMD, vset, set_size);
+				if(mask)
+					return first + count - TINYSTL_STRING_SIMD + string_highbit(mask);
+			}
+			return string_find_last_of_scalar(first, count, set, set_size);
+		}
+#endif
+
+		bool table[256] = {};
+		for(size_t ii = 0; ii < set_size; ++ii)
+			table[(unsigned char)set[ii]] = true;
+		while(count-- > 0)
+			if(table[(unsigned char)first[count]])
+				return first + count;
+		return nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_BUILDER_H
+#define TINYSTL_STRING_BUILDER_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_view.h>
+#include <TINYSTL/vector.h>
+
+namespace tinystl {
+
+	// appends the views to s, size being the final length of s. A view of
+	// the characters of s itself would dangle once s reallocates, so then the
+	// result is built in a new string that replaces s only when complete.
+	template<typename Alloc, size_t N>
+	static inline void string_append_views(basic_string<Alloc, N>& s, const string_view* first, const string_view* last, size_t size) {
+		const char* const str = s.data();
+		const char* const str_end = str + s.size();
+
+		bool aliased = false;
+		for(const string_view* it = first; it != last; ++it)
+			aliased = aliased || (!it->empty() && it->data() < str_end && it->data() + it->size() > str);
+
+		if(aliased) {
+			basic_string<Alloc, N> result;
+			result.reserve(size);
+			result.append(string_view(str, s.size()));
+			for(; first != last; ++first)
+				result.append(*first);
+			s.swap(result);
+			return;
+		}
+
+		s.reserve(size);
+		for(; first != last; ++first)
+			s.append(*first);
+	}
+
+	// Collects views of the pieces and copies them in one go once the total
+	// length is known. The pieces must outlive the builder.
+	template<typename Alloc>
+	class basic_string_builder {
+	public:
+		basic_string_builder();
+
+		basic_string_builder& append(string_view piece);
+		basic_string_builder& operator<<(string_view piece);
+
+		// a temporary string would be destroyed before its view is copied
+		template<typename StringAlloc, size_t N>
+		basic_string_builder& append(basic_string<StringAlloc, N>&& piece) = delete;
+		template<typename StringAlloc, size_t N>
+		basic_string_builder& operator<<(basic_string<StringAlloc, N>&& piece) = delete;
+
+		void reserve(size_t pieces);
+		void clear();
+
+		size_t size() const;
+		bool empty() const;
+
+		template<typename StringAlloc, size_t N>
+		void append_to(basic_string<StringAlloc, N>& s) const;
+
+		basic_string<Alloc> str() const;
+
+	private:
+		vector<string_view, Alloc> m_pieces;
+		size_t m_size;
+	};
+
+	template<typename Alloc>
+	inline basic_string_builder<Alloc>::basic_string_builder()
+		: m_size(0)
+	{
+	}
+
+	template<typename Alloc>
+	inline basic_string_builder<Alloc>& basic_string_builder<Alloc>::append(string_view piece) {
+		m_pieces.push_back(piece);
+		m_size += piece.size();
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline basic_string_builder<Alloc>& basic_string_builder<Alloc>::operator<<(string_view piece) {
+		return append(piece);
+	}
+
+	template<typename Alloc>
+	inline void basic_string_builder<Alloc>::reserve(size_t pieces) {
+		m_pieces.reserve(pieces);
+	}
+
+	template<typename Alloc>
+	inline void basic_string_builder<Alloc>::clear() {
+		m_pieces.clear();
+		m_size = 0;
+	}
+
+	template<typename Alloc>
+	inline size_t basic_string_builder<Alloc>::size() const {
+		return m_size;
+	}
+
+	template<typename Alloc>
+	inline bool basic_string_builder<Alloc>::empty() const {
+		return m_size == 0;
+	}
+
+	template<typename Alloc>
+	template<typename StringAlloc, size_t N>
+	inline void basic_string_builder<Alloc>::append_to(basic_string<StringAlloc, N>& s) const {
+		string_append_views(s, m_pieces.begin(), m_pieces.end(), s.size() + m_size);
+	}
+
+	template<typename Alloc>
+	inline basic_string<Alloc> basic_string_builder<Alloc>::str() const {
+		basic_string<Alloc> s;
+		append_to(s);
+		return s;
+	}
+
+	typedef basic_string_builder<TINYSTL_ALLOCATOR> string_builder;
+
+	// appends every piece to s after a single reserve
+	template<typename Alloc, size_t N, typename... Pieces>
+	static inline void concat_append(basic_string<Alloc, N>& s, const Pieces&... pieces) {
+		const string_view views[] = { string_view(), string_view(pieces)... };
+
+		size_t size = s.size();
+		for(const string_view& view : views)
+			size += view.size();
+
+		string_append_views(s, views, views + sizeof(views) / sizeof(views[0]), size);
+	}
+
+	template<typename... Pieces>
+	static inline string concat(const Pieces&... pieces) {
+		string s;
+		concat_append(s, pieces...);
+		return s;
+	}
+}
+
+#endif
@@ -0,0 +1,620 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_FORMAT_H
+#define TINYSTL_STRING_FORMAT_H
+
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_base.h>
+
+namespace tinystl {
+
+	static const char* const c_string_digit_pairs =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	// longest output of string_format_double, e.g. "-0.0000012345678901234567"
+	static const size_t c_string_format_double_max = 32;
+
+	static inline size_t string_format_decimal_count(unsigned long long value) {
+		size_t count = 1;
+		for(;;) {
+			if(value < 10) return count;
+			if(value < 100) return count + 1;
+			if(value < 1000) return count + 2;
+			if(value < 10000) return count + 3;
+			value /= 10000;
+			count += 4;
+		}
+	}
+
+	// writes the decimal digits of value so that they end at last
+	static inline void string_format_decimal(char* last, unsigned long long value) {
+		while(value >= 100) {
+			const char* pair = c_string_digit_pairs + (value % 100) * 2;
+			value /= 100;
+			*--last = pair[1];
+			*--last = pair[0];
+		}
+
+		if(value >= 10) {
+			const char* pair = c_string_digit_pairs + value * 2;
+			*--last = pair[1];
+			*--last = pair[0];
+		} else {
+			*--last = (char)('0' + value);
+		}
+	}
+
+	static inline size_t string_format_hex_count(unsigned long long value) {
+		size_t count = 1;
+		while(value >>= 4)
+			++count;
+		return count;
+	}
+
+	static inline void string_format_hex(char* last, unsigned long long value) {
+		do {
+			*--last = "0123456789abcdef"[value & 0xf];
+			value >>= 4;
+		} while(value);
+	}
+
+	// Grisu3 (Loitsch, "Printing Floating-Point Numbers Quickly and
+	// Accurately with Integers") with an exact bignum fallback.
+
+	struct string_diy_fp {
+		unsigned long long f;
+		int e;
+	};
+
+	static inline string_diy_fp string_diy_fp_make(unsigned long long f, int e) {
+		string_diy_fp result = { f, e };
+		return result;
+	}
+
+	static inline string_diy_fp string_diy_fp_multiply(string_diy_fp x, string_diy_fp y) {
+		const unsigned long long mask = 0xffffffffull;
+		const unsigned long long a = x.f >> 32, b = x.f & mask, c = y.f >> 32, d = y.f & mask;
+		const unsigned long long ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+		unsigned long long tmp = (bd >> 32) + (ad & mask) + (bc & mask);
+		tmp += 1ull << 31;
+		return string_diy_fp_make(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+	}
+
+	static inline string_diy_fp string_diy_fp_normalize(string_diy_fp x) {
+		while(!(x.f & (1ull << 63))) {
+			x.f <<= 1;
+			--x.e;
+		}
+		return x;
+	}
+
+	// 10^(-348 + 8 * index) for index in [0, 87) as a normalized 64 bit significand and binary exponent
+	static inline string_diy_fp string_cached_power_at(unsigned index) {
+		static const unsigned long long f[] = {
+			0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull, 0xcf42894a5dce35eaull,
+			0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull, 0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full,
+			0xbe5691ef416bd60cull, 0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+			0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull, 0xc21094364dfb5637ull,
+			0x9096ea6f3848984full, 0xd77485cb25823ac7ull, 0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull,
+			0xb23867fb2a35b28eull, 0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+			0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull, 0xb5b5ada8aaff80b8ull,
+			0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull, 0x964e858c91ba2655ull, 0xdff9772470297ebdull,
+			0xa6dfbd9fb8e5b88full, 0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+			0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull, 0xaa242499697392d3ull,
+			0xfd87b5f28300ca0eull, 0xbce5086492111aebull, 0x8cbccc096f5088ccull, 0xd1b71758e219652cull,
+			0x9c40000000000000ull, 0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+			0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull, 0x9f4f2726179a2245ull,
+			0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull, 0x83c7088e1aab65dbull, 0xc45d1df942711d9aull,
+			0x924d692ca61be758ull, 0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+			0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull, 0x952ab45cfa97a0b3ull,
+			0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull, 0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull,
+			0x88fcf317f22241e2ull, 0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+			0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull, 0x8bab8eefb6409c1aull,
+			0xd01fef10a657842cull, 0x9b10a4e5e9913129ull, 0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull,
+			0x80444b5e7aa7cf85ull, 0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+			0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+		};
+		static const short e2[] = {
+			-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+			-901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+			-582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+			-263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+			56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+			375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+			694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+			1013, 1039, 1066
+		};
+
+		return string_diy_fp_make(f[index], e2[index]);
+	}
+
+	static inline string_diy_fp string_cached_power(int e, int* k) {
+		// smallest cached power that brings e into [-60, -32]
+		const double dk = (-61 - e) * 0.30102999566398114 + 347;
+		int ik = (int)dk;
+		if(dk - ik > 0.0)
+			++ik;
+
+		const unsigned index = (unsigned)((ik >> 3) + 1);
+		*k = -(-348 + (int)(index << 3));
+		return string_cached_power_at(index);
+	}
+
+	static inline unsigned string_grisu_count_digits(unsigned n) {
+		if(n < 10) return 1;
+		if(n < 100) return 2;
+		if(n < 1000) return 3;
+		if(n < 10000) return 4;
+		if(n < 100000) return 5;
+		if(n < 1000000) return 6;
+		if(n < 10000000) return 7;
+		if(n < 100000000) return 8;
+		if(n < 1000000000) return 9;
+		return 10;
+	}
+
+	static const unsigned long long c_string_pow10[] = {
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+		10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+		1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+	};
+
+	// moves the last digit towards w; fails when the digits cannot be proven shortest and closest
+	static inline bool string_grisu3_weed(char* buffer, size_t len, unsigned long long distance_too_high_w, unsigned long long unsafe_interval, unsigned long long rest, unsigned long long ten_kappa, unsigned long long unit) {
+		const unsigned long long small_distance = distance_too_high_w - unit;
+		const unsigned long long big_distance = distance_too_high_w + unit;
+
+		while(rest < small_distance && unsafe_interval - rest >= ten_kappa
+			&& (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)) {
+			buffer[len - 1]--;
+			rest += ten_kappa;
+		}
+
+		if(rest < big_distance && unsafe_interval - rest >= ten_kappa
+			&& (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance))
+			return false;
+
+		return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+	}
+
+	static inline bool string_grisu3_digits(string_diy_fp low, string_diy_fp w, string_diy_fp high, char* buffer, size_t* len, int* kappa) {
+		unsigned long long unit = 1;
+		const string_diy_fp too_low = string_diy_fp_make(low.f - unit, low.e);
+		const string_diy_fp too_high = string_diy_fp_make(high.f + unit, high.e);
+		unsigned long long unsafe_interval = too_high.f - too_low.f;
+
+		const string_diy_fp one = string_diy_fp_make(1ull << -w.e, w.e);
+		unsigned integrals = (unsigned)(too_high.f >> -one.e);
+		unsigned long long fractionals = too_high.f & (one.f - 1);
+
+		*kappa = (int)string_grisu_count_digits(integrals);
+		*len = 0;
+
+		while(*kappa > 0) {
+			const unsigned divisor = (unsigned)c_string_pow10[*kappa - 1];
+			buffer[(*len)++] = (char)('0' + integrals / divisor);
+			integrals %= divisor;
+			--*kappa;
+
+			const unsigned long long rest = ((unsigned long long)integrals << -one.e) + fractionals;
+			if(rest < unsafe_interval)
+				return string_grisu3_weed(buffer, *len, too_high.f - w.f, unsafe_interval, rest, (unsigned long long)divisor << -one.e, unit);
+		}
+
+		for(;;) {
+			fractionals *= 10;
+			unit *= 10;
+			unsafe_interval *= 10;
+
+			buffer[(*len)++] = (char)('0' + (fractionals >> -one.e));
+			fractionals &= one.f - 1;
+			--*kappa;
+
+			if(fractionals < unsafe_interval)
+				return string_grisu3_weed(buffer, *len, (too_high.f - w.f) * unit, unsafe_interval, fractionals, one.f, unit);
+		}
+	}
+
+	// Grisu3: shortest digits of a positive finite value with value == digits * 10^k, or false
+	// for the rare inputs where 64 bit arithmetic cannot decide
+	static inline bool string_grisu3(unsigned long long f, int e, char* buffer, size_t* len, int* k) {
+		const unsigned long long hidden = 1ull << 52;
+
+		// boundaries halfway to the neighbouring doubles, with the same exponent
+		const string_diy_fp plus = string_diy_fp_normalize(string_diy_fp_make((f << 1) + 1, e - 1));
+		string_diy_fp minus = (f == hidden && e > -1074)
+			? string_diy_fp_make((f << 2) - 1, e - 2)
+			: string_diy_fp_make((f << 1) - 1, e - 1);
+		minus.f <<= minus.e - plus.e;
+		minus.e = plus.e;
+
+		int mk;
+		const string_diy_fp c_mk = string_cached_power(plus.e, &mk);
+		const string_diy_fp w = string_diy_fp_multiply(string_diy_fp_normalize(string_diy_fp_make(f, e)), c_mk);
+		const string_diy_fp high = string_diy_fp_multiply(plus, c_mk);
+		const string_diy_fp low = string_diy_fp_multiply(minus, c_mk);
+
+		int kappa;
+		if(!string_grisu3_digits(low, w, high, buffer, len, &kappa))
+			return false;
+
+		*k = mk + kappa;
+		return true;
+	}
+
+	// arbitrary precision unsigned integer, large enough for exact conversions in both directions
+	struct string_bignum {
+		unsigned limbs[128];
+		size_t size;
+	};
+
+	static inline void string_bignum_set(string_bignum& b, unsigned long long value) {
+		b.size = 0;
+		for(; value; value >>= 32)
+			b.limbs[b.size++] = (unsigned)value;
+	}
+
+	static inline void string_bignum_multiply(string_bignum& b, unsigned factor) {
+		unsigned long long carry = 0;
+		for(size_t ii = 0; ii < b.size; ++ii) {
+			carry += (unsigned long long)b.limbs[ii] * factor;
+			b.limbs[ii] = (unsigned)carry;
+			carry >>= 32;
+		}
+		if(carry)
+			b.limbs[b.size++] = (unsigned)carry;
+	}
+
+	static inline void string_bignum_multiply_pow10(string_bignum& b, unsigned exponent) {
+		for(; exponent >= 9; exponent -= 9)
+			string_bignum_multiply(b, 1000000000u);
+		string_bignum_multiply(b, (unsigned)c_string_pow10[exponent]);
+	}
+
+	static inline void string_bignum_shift_left(string_bignum& b, unsigned bits) {
+		if(b.size == 0)
+			return;
+
+		const size_t limbs = bits / 32;
+		bits %= 32;
+
+		if(bits) {
+			b.limbs[b.size] = 0;
+			for(size_t ii = b.size; ii > 0; --ii)
+				b.limbs[ii] = (b.limbs[ii] << bits) | (b.limbs[ii - 1] >> (32 - bits));
+			b.limbs[0] <<= bits;
+			if(b.limbs[b.size])
+				++b.size;
+		}
+
+		if(limbs) {
+			for(size_t ii = b.size; ii > 0; --ii)
+				b.limbs[ii - 1 + limbs] = b.limbs[ii - 1];
+			for(size_t ii = 0; ii < limbs; ++ii)
+				b.limbs[ii] = 0;
+			b.size += limbs;
+		}
+	}
+
+	static inline int string_bignum_compare(const string_bignum& a, const string_bignum& b) {
+		if(a.size != b.size)
+			return a.size < b.size ? -1 : 1;
+		for(size_t ii = a.size; ii > 0; --ii) {
+			if(a.limbs[ii - 1] != b.limbs[ii - 1])
+				return a.limbs[ii - 1] < b.limbs[ii - 1] ? -1 : 1;
+		}
+		return 0;
+	}
+
+	// compares a + b with c
+	static inline int string_bignum_compare_sum(const string_bignum& a, const string_bignum& b, const string_bignum& c) {
+		string_bignum sum;
+		const string_bignum& longer = a.size < b.size ? b : a;
+		const string_bignum& shorter = a.size < b.size ? a : b;
+		unsigned long long carry = 0;
+		for(size_t ii = 0; ii < longer.size; ++ii) {
+			carry += (unsigned long long)longer.limbs[ii] + (ii < shorter.size ? shorter.limbs[ii] : 0);
+			sum.limbs[ii] = (unsigned)carry;
+			carry >>= 32;
+		}
+		sum.size = longer.size;
+		if(carry)
+			sum.limbs[sum.size++] = (unsigned)carry;
+
+		return string_bignum_compare(sum, c);
+	}
+
+	// a -= b, where a >= b
+	static inline void string_bignum_subtract(string_bignum& a, const string_bignum& b) {
+		long long borrow = 0;
+		for(size_t ii = 0; ii < a.size; ++ii) {
+			borrow += (long long)a.limbs[ii] - (ii < b.size ? b.limbs[ii] : 0);
+			a.limbs[ii] = (unsigned)borrow;
+			borrow = borrow < 0 ? -1 : 0;
+		}
+		while(a.size && !a.limbs[a.size - 1])
+			--a.size;
+	}
+
+	// Exact shortest digits (Burger and Dybvig, "Printing Floating-Point
+	// Numbers Quickly and Accurately"), used when Grisu3 gives up.
+	static inline size_t string_dragon4(unsigned long long f, int e, char* buffer, int* k) {
+		const bool even = (f & 1) == 0;
+		const bool unequal_gaps = f == (1ull << 52) && e > -1074;
+
+		// value = r / s, with the half gaps to the neighbours m_plus / s and m_minus / s
+		string_bignum r, s, m_plus, m_minus;
+		string_bignum_set(r, f << (unequal_gaps ? 2 : 1));
+		string_bignum_set(s, unequal_gaps ? 4 : 2);
+		string_bignum_set(m_plus, unequal_gaps ? 2 : 1);
+		string_bignum_set(m_minus, 1);
+		if(e >= 0) {
+			string_bignum_shift_left(r, (unsigned)e);
+			string_bignum_shift_left(m_plus, (unsigned)e);
+			string_bignum_shift_left(m_minus, (unsigned)e);
+		} else {
+			string_bignum_shift_left(s, (unsigned)-e);
+		}
+
+		// estimate of ceil(log10(value)), at most one too small
+		int bits = 0;
+		for(unsigned long long it = f; it; it >>= 1)
+			++bits;
+		const double estimate = (e + bits - 1) * 0.30102999566398114 - 1e-10;
+		int exponent = (int)estimate;
+		if(estimate > exponent)
+			++exponent;
+
+		if(exponent >= 0) {
+			string_bignum_multiply_pow10(s, (unsigned)exponent);
+		} else {
+			string_bignum_multiply_pow10(r, (unsigned)-exponent);
+			string_bignum_multiply_pow10(m_plus, (unsigned)-exponent);
+			string_bignum_multiply_pow10(m_minus, (unsigned)-exponent);
+		}
+
+		const int high = string_bignum_compare_sum(r, m_plus, s);
+		if(even ? high >= 0 : high > 0) {
+			++exponent;
+		} else {
+			string_bignum_multiply(r, 10);
+			string_bignum_multiply(m_plus, 10);
+			string_bignum_multiply(m_minus, 10);
+		}
+
+		size_t len = 0;
+		for(;;) {
+			unsigned digit = 0;
+			while(string_bignum_compare(r, s) >= 0) {
+				string_bignum_subtract(r, s);
+				++digit;
+			}
+
+			const int low = string_bignum_compare(r, m_minus);
+			const int high_gap = string_bignum_compare_sum(r, m_plus, s);
+			const bool round_down = even ? low <= 0 : low < 0;
+			const bool round_up = even ? high_gap >= 0 : high_gap > 0;
+
+			if(!round_down && !round_up) {
+				buffer[len++] = (char)('0' + digit);
+				string_bignum_multiply(r, 10);
+				string_bignum_multiply(m_plus, 10);
+				string_bignum_multiply(m_minus, 10);
+				continue;
+			}
+
+			if(round_down && round_up) {
+				// closer to whichever digit is nearer, r * 2 against s
+				if(string_bignum_compare_sum(r, r, s) >= 0)
+					++digit;
+			} else if(round_up) {
+				++digit;
+			}
+
+			buffer[len++] = (char)('0' + digit);
+			break;
+		}
+
+		*k = exponent - (int)len;
+		return len;
+	}
+
+	// shortest digits of a positive finite value: value == digits * 10^k
+	static inline size_t string_format_shortest(double value, char* buffer, int* k) {
+		unsigned long long bits;
+		string_copy((char*)&bits, (const char*)&value, sizeof(bits));
+
+		const unsigned long long hidden = 1ull << 52;
+		const int biased_e = (int)((bits >> 52) & 0x7ff);
+		const unsigned long long significand = bits & (hidden - 1);
+		const unsigned long long f = biased_e ? significand + hidden : significand;
+		const int e = biased_e ? biased_e - 1075 : -1074;
+
+		size_t len;
+		if(string_grisu3(f, e, buffer, &len, k))
+			return len;
+		return string_dragon4(f, e, buffer, k);
+	}
+
+	// Chooses between positional and exponent notation like ECMAScript's
+	// Number.prototype.toString. Returns the number of characters written.
+	static inline size_t string_format_double(char* out, double value) {
+		unsigned long long bits;
+		string_copy((char*)&bits, (const char*)&value, sizeof(bits));
+
+		char* it = out;
+		if(bits >> 63) {
+			*it++ = '-';
+			bits &= ~(1ull << 63);
+			value = -value;
+		}
+
+		if((bits >> 52) == 0x7ff) {
+			const char* text = (bits & ((1ull << 52) - 1)) ? "nan" : "inf";
+			if(text[0] == 'n')
+				it = out;
+			string_copy(it, text, 3);
+			return (size_t)(it + 3 - out);
+		}
+
+		if(bits == 0) {
+			*it = '0';
+			return (size_t)(it + 1 - out);
+		}
+
+		char digits[20];
+		int k;
+		const int len = (int)string_format_shortest(value, digits, &k);
+
+		// position of the decimal point relative to the first digit
+		const int point = len + k;
+		if(len <= point && point <= 21) {
+			string_copy(it, digits, (size_t)len);
+			it += len;
+			for(int ii = len; ii < point; ++ii)
+				*it++ = '0';
+		} else if(0 < point && point <= 21) {
+			string_copy(it, digits, (size_t)point);
+			it += point;
+			*it++ = '.';
+			string_copy(it, digits + point, (size_t)(len - point));
+			it += len - point;
+		} else if(-6 < point && point <= 0) {
+			*it++ = '0';
+			*it++ = '.';
+			for(int ii = point; ii < 0; ++ii)
+				*it++ = '0';
+			string_copy(it, digits, (size_t)len);
+			it += len;
+		} else {
+			*it++ = digits[0];
+			if(len > 1) {
+				*it++ = '.';
+				string_copy(it, digits + 1, (size_t)(len - 1));
+				it += len - 1;
+			}
+
+			const int exponent = point - 1;
+			*it++ = 'e';
+			*it++ = exponent < 0 ? '-' : '+';
+			const unsigned magnitude = (unsigned)(exponent < 0 ? -exponent : exponent);
+			const size_t count = string_format_decimal_count(magnitude);
+			string_format_decimal(it + count, magnitude);
+			it += count;
+		}
+
+		return (size_t)(it - out);
+	}
+
+	// makes room for count more characters at the end of s and returns the first
+	// of them, or nullptr when s is a fixed string that cannot hold them all
+	template<typename Alloc, size_t N>
+	static inline char* string_append_space(basic_string<Alloc, N>& s, size_t count) {
+		const size_t size = s.size();
+		if(string_is_fixed<Alloc>::value && size + count > s.capacity())
+			return nullptr;
+		s.resize(size + count);
+		return s.data() + size;
+	}
+
+	template<typename Alloc, size_t N>
+	static inline void append_uint(basic_string<Alloc, N>& s, unsigned long long value) {
+		const size_t count = string_format_decimal_count(value);
+		if(char* const first = string_append_space(s, count)) {
+			string_format_decimal(first + count, value);
+			return;
+		}
+
+		// a fixed string keeps the leading characters that fit
+		char temp[c_string_format_double_max];
+		char* const last = temp + c_string_format_double_max;
+		string_format_decimal(last, value);
+		s.append(last - count, last);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline void append_int(basic_string<Alloc, N>& s, long long value) {
+		if(value >= 0) {
+			append_uint(s, (unsigned long long)value);
+			return;
+		}
+
+		const unsigned long long magnitude = (unsigned long long)(-(value + 1)) + 1;
+		const size_t count = string_format_decimal_count(magnitude) + 1;
+		if(char* const first = string_append_space(s, count)) {
+			*first = '-';
+			string_format_decimal(first + count, magnitude);
+			return;
+		}
+
+		char temp[c_string_format_double_max];
+		char* const last = temp + c_string_format_double_max;
+		string_format_decimal(last, magnitude);
+		*(last - count) = '-';
+		s.append(last - count, last);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline void append_hex(basic_string<Alloc, N>& s, unsigned long long value) {
+		const size_t count = string_format_hex_count(value);
+		if(char* const first = string_append_space(s, count)) {
+			string_format_hex(first + count, value);
+			return;
+		}
+
+		char temp[c_string_format_double_max];
+		char* const last = temp + c_string_format_double_max;
+		string_format_hex(last, value);
+		s.append(last - count, last);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline void append_double(basic_string<Alloc, N>& s, double value) {
+		// room for the longest result, trimmed to the characters written
+		const size_t size = s.size();
+		if(char* const first = string_append_space(s, c_string_format_double_max)) {
+			s.resize(size + string_format_double(first, value));
+			return;
+		}
+
+		char temp[c_string_format_double_max];
+		const size_t count = string_format_double(temp, value);
+		s.append(temp, temp + count);
+	}
+}
+
+#endif
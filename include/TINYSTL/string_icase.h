@@ -0,0 +1,257 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_ICASE_H
+#define TINYSTL_STRING_ICASE_H
+
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	// hash_string of the ascii lowercase form of str, folded a block at a time
+	static inline size_t hash_string_icase(const char* str, size_t len) {
+		size_t hash = 0;
+#if defined(TINYSTL_STRING_SIMD)
+		char folded[TINYSTL_STRING_SIMD];
+		for(; len >= TINYSTL_STRING_SIMD; len -= TINYSTL_STRING_SIMD, str += TINYSTL_STRING_SIMD) {
+			string_simd_store_tolower(folded, str);
+			for(size_t ii = 0; ii < TINYSTL_STRING_SIMD; ++ii)
+				hash = folded[ii] + (hash << 6) + (hash << 16) - hash;
+		}
+#endif
+		for(; len; --len, ++str)
+			hash = string_tolower_scalar(*str) + (hash << 6) + (hash << 16) - hash;
+		return hash;
+	}
+
+	static constexpr bool iequals(string_view a, string_view b) {
+		return a.size() == b.size() && TINYSTL_STRING_KERNEL(string_iequal, a.data(), b.data(), a.size());
+	}
+
+	// orders a and b by their ascii lowercase forms
+	static constexpr int icompare(string_view a, string_view b) {
+		const size_t size = a.size() < b.size() ? a.size() : b.size();
+		for(size_t ii = 0; ii < size; ++ii) {
+			const char lhs = string_tolower_scalar(a.data()[ii]);
+			const char rhs = string_tolower_scalar(b.data()[ii]);
+			if(lhs != rhs)
+				return lhs < rhs ? -1 : 1;
+		}
+		return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+	}
+
+	// A hash container key that hashes and compares ignoring ascii case.
+	// The viewed characters must outlive the container.
+	class icase_string_view : public string_view {
+	public:
+		constexpr icase_string_view();
+		constexpr icase_string_view(const char* s);
+		constexpr icase_string_view(const char* s, size_t len);
+		constexpr icase_string_view(string_view v);
+	};
+
+	constexpr icase_string_view::icase_string_view() {
+	}
+
+	constexpr icase_string_view::icase_string_view(const char* s)
+		: string_view(s)
+	{
+	}
+
+	constexpr icase_string_view::icase_string_view(const char* s, size_t len)
+		: string_view(s, len)
+	{
+	}
+
+	constexpr icase_string_view::icase_string_view(string_view v)
+		: string_view(v)
+	{
+	}
+
+	static constexpr bool operator==(const icase_string_view& lhs, const icase_string_view& rhs) {
+		return iequals(lhs, rhs);
+	}
+
+	static constexpr bool operator!=(const icase_string_view& lhs, const icase_string_view& rhs) {
+		return !iequals(lhs, rhs);
+	}
+
+	static inline size_t hash(const icase_string_view& value) {
+		return hash_string_icase(value.data(), value.size());
+	}
+
+	// An owning key that hashes and compares ignoring ascii case, also
+	// against literals and views. A lookup in a container of them still
+	// builds a key, which stays inline up to the inline capacity; key the
+	// container by icase_string_view to look up without building one.
+	template<typename Alloc, size_t N = 0>
+	class basic_icase_string : public basic_string<Alloc, N> {
+	public:
+		basic_icase_string();
+		basic_icase_string(const char* s);
+		basic_icase_string(const char* s, size_t len);
+		basic_icase_string(string_view v);
+	};
+
+	template<typename Alloc, size_t N>
+	inline basic_icase_string<Alloc, N>::basic_icase_string() {
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_icase_string<Alloc, N>::basic_icase_string(const char* s)
+		: basic_string<Alloc, N>(s)
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_icase_string<Alloc, N>::basic_icase_string(const char* s, size_t len)
+		: basic_string<Alloc, N>(s, len)
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	inline basic_icase_string<Alloc, N>::basic_icase_string(string_view v)
+		: basic_string<Alloc, N>(v)
+	{
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator==(const basic_icase_string<Alloc, N>& lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator!=(const basic_icase_string<Alloc, N>& lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return !iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator<(const basic_icase_string<Alloc, N>& lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return icompare(lhs, rhs) < 0;
+	}
+
+	template<typename Alloc, size_t N, typename RAlloc, size_t RN>
+	static inline bool operator==(const basic_icase_string<Alloc, N>& lhs, const basic_string<RAlloc, RN>& rhs) {
+		return iequals(lhs, rhs);
+	}
+
+	template<typename LAlloc, size_t LN, typename Alloc, size_t N>
+	static inline bool operator==(const basic_string<LAlloc, LN>& lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N, typename RAlloc, size_t RN>
+	static inline bool operator!=(const basic_icase_string<Alloc, N>& lhs, const basic_string<RAlloc, RN>& rhs) {
+		return !iequals(lhs, rhs);
+	}
+
+	template<typename LAlloc, size_t LN, typename Alloc, size_t N>
+	static inline bool operator!=(const basic_string<LAlloc, LN>& lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return !iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N, typename RAlloc, size_t RN>
+	static inline bool operator<(const basic_icase_string<Alloc, N>& lhs, const basic_string<RAlloc, RN>& rhs) {
+		return icompare(lhs, rhs) < 0;
+	}
+
+	template<typename LAlloc, size_t LN, typename Alloc, size_t N>
+	static inline bool operator<(const basic_string<LAlloc, LN>& lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return icompare(lhs, rhs) < 0;
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator==(const basic_icase_string<Alloc, N>& lhs, string_view rhs) {
+		return iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator==(string_view lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator!=(const basic_icase_string<Alloc, N>& lhs, string_view rhs) {
+		return !iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator!=(string_view lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return !iequals(lhs, rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator<(const basic_icase_string<Alloc, N>& lhs, string_view rhs) {
+		return icompare(lhs, rhs) < 0;
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator<(string_view lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return icompare(lhs, rhs) < 0;
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator==(const basic_icase_string<Alloc, N>& lhs, const char* rhs) {
+		return iequals(lhs, string_view(rhs, string_length(rhs)));
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator==(const char* lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return iequals(string_view(lhs, string_length(lhs)), rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator!=(const basic_icase_string<Alloc, N>& lhs, const char* rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator!=(const char* lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator<(const basic_icase_string<Alloc, N>& lhs, const char* rhs) {
+		return icompare(lhs, string_view(rhs, string_length(rhs))) < 0;
+	}
+
+	template<typename Alloc, size_t N>
+	static inline bool operator<(const char* lhs, const basic_icase_string<Alloc, N>& rhs) {
+		return icompare(string_view(lhs, string_length(lhs)), rhs) < 0;
+	}
+
+	template<typename Alloc, size_t N>
+	static inline size_t hash(const basic_icase_string<Alloc, N>& value) {
+		return hash_string_icase(value.data(), value.size());
+	}
+
+	typedef basic_icase_string<TINYSTL_ALLOCATOR> icase_string;
+}
+
+#endif
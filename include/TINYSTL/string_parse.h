@@ -0,0 +1,520 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_PARSE_H
+#define TINYSTL_STRING_PARSE_H
+
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_format.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	enum from_chars_error {
+		from_chars_ok,
+		// no number at the start of the input, ptr is the start of the input
+		from_chars_invalid,
+		// the number does not fit the destination, ptr is past the number and the value is untouched
+		from_chars_out_of_range,
+	};
+
+	struct from_chars_result {
+		const char* ptr;
+		from_chars_error error;
+	};
+
+	static inline from_chars_result string_parse_result(const char* ptr, from_chars_error error) {
+		from_chars_result result = { ptr, error };
+		return result;
+	}
+
+	static inline bool string_parse_is_digit(char c) {
+		return (unsigned)(c - '0') < 10;
+	}
+
+	// eight characters as a little endian word, whatever the host byte order
+	static inline unsigned long long string_parse_load8(const char* s) {
+		unsigned char b[8];
+		string_copy((char*)b, s, 8);
+		return (unsigned long long)b[0] | (unsigned long long)b[1] << 8
+			| (unsigned long long)b[2] << 16 | (unsigned long long)b[3] << 24
+			| (unsigned long long)b[4] << 32 | (unsigned long long)b[5] << 40
+			| (unsigned long long)b[6] << 48 | (unsigned long long)b[7] << 56;
+	}
+
+	static inline bool string_parse_is_8digits(unsigned long long chunk) {
+		return ((chunk & 0xf0f0f0f0f0f0f0f0ull) | (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) == 0x3333333333333333ull;
+	}
+
+	// value of eight ascii digits, combining pairs, then quads, then halves
+	static inline unsigned string_parse_8digits(unsigned long long chunk) {
+		const unsigned long long mask = 0x000000ff000000ffull;
+		chunk -= 0x3030303030303030ull;
+		chunk = chunk * 10 + (chunk >> 8);
+		return (unsigned)(((chunk & mask) * (100 + (1000000ull << 32)) + ((chunk >> 16) & mask) * (1 + (10000ull << 32))) >> 32);
+	}
+
+	// Accumulates up to max_digits decimal digits into value, eight at a
+	// time while they last. Returns the end of the consumed digits.
+	static inline const char* string_parse_decimal(const char* first, const char* last, unsigned long long& value, size_t max_digits) {
+		const char* it = first;
+		while(last - it >= 8 && (size_t)(it - first) + 8 <= max_digits) {
+			const unsigned long long chunk = string_parse_load8(it);
+			if(!string_parse_is_8digits(chunk))
+				break;
+			value = value * 100000000 + string_parse_8digits(chunk);
+			it += 8;
+		}
+
+		for(; it != last && (size_t)(it - first) < max_digits && string_parse_is_digit(*it); ++it)
+			value = value * 10 + (unsigned)(*it - '0');
+		return it;
+	}
+
+	static inline unsigned string_parse_digit_value(char c) {
+		if(string_parse_is_digit(c))
+			return (unsigned)(c - '0');
+		if(c >= 'a' && c <= 'z')
+			return (unsigned)(c - 'a' + 10);
+		if(c >= 'A' && c <= 'Z')
+			return (unsigned)(c - 'A' + 10);
+		return 36;
+	}
+
+	// Parses an optional '-' (when is_signed) and digits in base. The
+	// magnitude may be at most max, or max + 1 when negative.
+	static inline from_chars_result string_parse_integer(const char* first, const char* last, int base, bool is_signed, unsigned long long max, unsigned long long& magnitude, bool& negative) {
+		const char* it = first;
+		negative = is_signed && it != last && *it == '-';
+		if(negative)
+			++it;
+
+		const unsigned long long limit = negative ? max + 1 : max;
+		unsigned long long value = 0;
+		bool overflow = false;
+		const char* digits = it;
+
+		if(base == 10) {
+			while(it != last && *it == '0')
+				++it;
+
+			// nineteen digits always fit
+			it = string_parse_decimal(it, last, value, 19);
+			for(; it != last && string_parse_is_digit(*it); ++it) {
+				const unsigned digit = (unsigned)(*it - '0');
+				if(value > (~0ull - digit) / 10)
+					overflow = true;
+				else
+					value = value * 10 + digit;
+			}
+		} else {
+			unsigned digit;
+			for(; it != last && (digit = string_parse_digit_value(*it)) < (unsigned)base; ++it) {
+				if(value > (~0ull - digit) / (unsigned)base)
+					overflow = true;
+				else
+					value = value * (unsigned)base + digit;
+			}
+		}
+
+		if(it == digits)
+			return string_parse_result(first, from_chars_invalid);
+		if(overflow || value > limit)
+			return string_parse_result(it, from_chars_out_of_range);
+
+		magnitude = value;
+		return string_parse_result(it, from_chars_ok);
+	}
+
+	static inline from_chars_result from_chars(const char* first, const char* last, long long& value, int base = 10) {
+		unsigned long long magnitude;
+		bool negative;
+		const from_chars_result result = string_parse_integer(first, last, base, true, ~0ull >> 1, magnitude, negative);
+		if(result.error == from_chars_ok)
+			value = negative && magnitude ? -(long long)(magnitude - 1) - 1 : (long long)magnitude;
+		return result;
+	}
+
+	static inline from_chars_result from_chars(const char* first, const char* last, long& value, int base = 10) {
+		unsigned long long magnitude;
+		bool negative;
+		const from_chars_result result = string_parse_integer(first, last, base, true, ~0ul >> 1, magnitude, negative);
+		if(result.error == from_chars_ok)
+			value = negative && magnitude ? -(long)(magnitude - 1) - 1 : (long)magnitude;
+		return result;
+	}
+
+	static inline from_chars_result from_chars(const char* first, const char* last, int& value, int base = 10) {
+		unsigned long long magnitude;
+		bool negative;
+		const from_chars_result result = string_parse_integer(first, last, base, true, ~0u >> 1, magnitude, negative);
+		if(result.error == from_chars_ok)
+			value = negative && magnitude ? -(int)(magnitude - 1) - 1 : (int)magnitude;
+		return result;
+	}
+
+	static inline from_chars_result from_chars(const char* first, const char* last, unsigned long long& value, int base = 10) {
+		unsigned long long magnitude;
+		bool negative;
+		const from_chars_result result = string_parse_integer(first, last, base, false, ~0ull, magnitude, negative);
+		if(result.error == from_chars_ok)
+			value = magnitude;
+		return result;
+	}
+
+	static inline from_chars_result from_chars(const char* first, const char* last, unsigned long& value, int base = 10) {
+		unsigned long long magnitude;
+		bool negative;
+		const from_chars_result result = string_parse_integer(first, last, base, false, ~0ul, magnitude, negative);
+		if(result.error == from_chars_ok)
+			value = (unsigned long)magnitude;
+		return result;
+	}
+
+	static inline from_chars_result from_chars(const char* first, const char* last, unsigned& value, int base = 10) {
+		unsigned long long magnitude;
+		bool negative;
+		const from_chars_result result = string_parse_integer(first, last, base, false, ~0u, magnitude, negative);
+		if(result.error == from_chars_ok)
+			value = (unsigned)magnitude;
+		return result;
+	}
+
+	// Doubles are read exactly: small inputs take Clinger's fast path, the
+	// rest get a 64 bit estimate that is checked against the exact decimal
+	// value with bignums when it lands too close to a rounding boundary.
+
+#if defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ != 0
+	static const bool c_string_parse_fast_path = false;
+#else
+	static const bool c_string_parse_fast_path = true;
+#endif
+
+	// digits beyond this only decide ties, and are folded into a sticky digit
+	static const size_t c_string_parse_max_digits = 780;
+
+	static inline double string_parse_make_double(unsigned long long bits) {
+		double value;
+		string_copy((char*)&value, (const char*)&bits, sizeof(value));
+		return value;
+	}
+
+	static inline bool string_parse_match_icase(const char* first, const char* last, const char* word) {
+		for(; *word; ++first, ++word) {
+			if(first == last || (*first | 0x20) != *word)
+				return false;
+		}
+		return true;
+	}
+
+	struct string_parse_decimal_digits {
+		// the significant digits of the input, possibly interrupted by a '.'
+		const char* first;
+		const char* last;
+		size_t count;
+		// value == digits * 10^exponent
+		long long exponent;
+	};
+
+	static inline void string_bignum_add(string_bignum& b, unsigned value) {
+		unsigned long long carry = value;
+		for(size_t ii = 0; carry && ii < b.size; ++ii) {
+			carry += b.limbs[ii];
+			b.limbs[ii] = (unsigned)carry;
+			carry >>= 32;
+		}
+		if(carry)
+			b.limbs[b.size++] = (unsigned)carry;
+	}
+
+	static inline void string_parse_digits_bignum(const string_parse_decimal_digits& digits, string_bignum& b, long long& exponent) {
+		string_bignum_set(b, 0);
+		exponent = digits.exponent;
+
+		size_t remaining = digits.count;
+		const char* it = digits.first;
+		unsigned chunk = 0, chunk_digits = 0;
+		for(size_t used = 0; used < c_string_parse_max_digits - 1 && remaining; ++it) {
+			if(*it == '.')
+				continue;
+			chunk = chunk * 10 + (unsigned)(*it - '0');
+			--remaining;
+			++used;
+			if(++chunk_digits == 9) {
+				string_bignum_multiply(b, 1000000000u);
+				string_bignum_add(b, chunk);
+				chunk = chunk_digits = 0;
+			}
+		}
+
+		// a sticky digit keeps dropped non-zero digits from ever looking like a tie
+		exponent += (long long)remaining;
+		if(remaining) {
+			bool sticky = false;
+			for(; it != digits.last; ++it)
+				sticky |= *it != '0' && *it != '.';
+			if(sticky) {
+				chunk = chunk * 10 + 1;
+				++chunk_digits;
+				--exponent;
+			}
+		}
+
+		string_bignum_multiply(b, (unsigned)c_string_pow10[chunk_digits]);
+		string_bignum_add(b, chunk);
+	}
+
+	// compares the decimal value with m * 2^e
+	static inline int string_parse_compare(const string_bignum& digits, long long exponent, unsigned long long m, int e) {
+		string_bignum lhs, rhs;
+		lhs = digits;
+		string_bignum_set(rhs, m);
+		if(exponent >= 0)
+			string_bignum_multiply_pow10(lhs, (unsigned)exponent);
+		else
+			string_bignum_multiply_pow10(rhs, (unsigned)-exponent);
+		if(e >= 0)
+			string_bignum_shift_left(rhs, (unsigned)e);
+		else
+			string_bignum_shift_left(lhs, (unsigned)-e);
+		return string_bignum_compare(lhs, rhs);
+	}
+
+	// moves the estimate to the correctly rounded neighbour, ties to even
+	static inline unsigned long long string_parse_refine(const string_parse_decimal_digits& digits, unsigned long long bits) {
+		string_bignum b;
+		long long exponent;
+		string_parse_digits_bignum(digits, b, exponent);
+
+		const unsigned long long hidden = 1ull << 52;
+		const unsigned long long infinity = 0x7ffull << 52;
+		for(;;) {
+			const int biased_e = (int)(bits >> 52);
+			const unsigned long long m = biased_e ? (bits & (hidden - 1)) + hidden : bits;
+			const int e = biased_e ? biased_e - 1075 : -1074;
+
+			if(bits != infinity) {
+				const int high = string_parse_compare(b, exponent, 2 * m + 1, e - 1);
+				if(high > 0 || (high == 0 && (m & 1))) {
+					++bits;
+					continue;
+				}
+			}
+
+			if(bits == 0)
+				return bits;
+
+			const bool unequal_gaps = m == hidden && e > -1074;
+			const int low = unequal_gaps
+				? string_parse_compare(b, exponent, 4 * m - 1, e - 2)
+				: string_parse_compare(b, exponent, 2 * m - 1, e - 1);
+			if(low < 0 || (low == 0 && (m & 1))) {
+				--bits;
+				continue;
+			}
+			return bits;
+		}
+	}
+
+	static inline unsigned long long string_parse_double_bits(unsigned long long mantissa, long long exponent, bool truncated, const string_parse_decimal_digits& digits) {
+		static const double pow10[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+		};
+
+		if(c_string_parse_fast_path && !truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+			double value = (double)mantissa;
+			if(exponent < 0)
+				value /= pow10[-exponent];
+			else
+				value *= pow10[exponent];
+
+			unsigned long long bits;
+			string_copy((char*)&bits, (const char*)&value, sizeof(bits));
+			return bits;
+		}
+
+		// the value lies in [10^(exponent + count - 1), 10^(exponent + count))
+		const long long magnitude = exponent + (long long)string_format_decimal_count(mantissa);
+		if(magnitude > 309)
+			return 0x7ffull << 52;
+		if(magnitude < -324)
+			return 0;
+
+		// mantissa * 10^rem * 10^k with k a cached power
+		const int index = (int)((exponent + 348) / 8);
+		const int rem = (int)(exponent + 348 - index * 8);
+		string_diy_fp w = string_diy_fp_normalize(string_diy_fp_make(mantissa, 0));
+		if(rem)
+			w = string_diy_fp_normalize(string_diy_fp_multiply(w, string_diy_fp_normalize(string_diy_fp_make(c_string_pow10[rem], 0))));
+		w = string_diy_fp_normalize(string_diy_fp_multiply(w, string_cached_power_at((unsigned)index)));
+
+		// error of the estimate in units of its last bit
+		const unsigned long long error = truncated ? 32 : 8;
+
+		// bits below the precision of the result, more for subnormals
+		int shift = 11;
+		if(w.e + 63 < -1022)
+			shift += -1022 - (w.e + 63);
+		if(shift >= 64)
+			return string_parse_refine(digits, 0);
+
+		const unsigned long long low = w.f & ((1ull << shift) - 1);
+		const unsigned long long half = 1ull << (shift - 1);
+		unsigned long long m = (w.f >> shift) + (low > half);
+		int e = w.e + shift;
+		if(m == (1ull << 53)) {
+			m >>= 1;
+			++e;
+		}
+
+		const unsigned long long bits = e > 971 ? 0x7ffull << 52 : ((unsigned long long)(e + 1074) << 52) + m;
+		if((low > half ? low - half : half - low) > error)
+			return bits;
+		return string_parse_refine(digits, bits);
+	}
+
+	// Reads [-]digits[.digits][(e|E)[+|-]digits], "inf", "infinity" or
+	// "nan" without regard to the current locale. Leading whitespace and
+	// '+' are not accepted.
+	static inline from_chars_result from_chars(const char* first, const char* last, double& value) {
+		const char* it = first;
+		const bool negative = it != last && *it == '-';
+		if(negative)
+			++it;
+		const unsigned long long sign = negative ? 1ull << 63 : 0;
+
+		if(it != last && !string_parse_is_digit(*it) && *it != '.') {
+			if(string_parse_match_icase(it, last, "inf")) {
+				it += 3;
+				if(string_parse_match_icase(it, last, "inity"))
+					it += 5;
+				value = string_parse_make_double(sign | 0x7ffull << 52);
+				return string_parse_result(it, from_chars_ok);
+			}
+
+			if(string_parse_match_icase(it, last, "nan")) {
+				it += 3;
+				if(it != last && *it == '(') {
+					const char* close = it + 1;
+					while(close != last && (string_parse_digit_value(*close) < 36 || *close == '_'))
+						++close;
+					if(close != last && *close == ')')
+						it = close + 1;
+				}
+				value = string_parse_make_double(sign | 0x7ff8ull << 48);
+				return string_parse_result(it, from_chars_ok);
+			}
+
+			return string_parse_result(first, from_chars_invalid);
+		}
+
+		string_parse_decimal_digits digits;
+		unsigned long long mantissa = 0;
+		bool truncated = false;
+
+		// the first nineteen significant digits go into mantissa
+		const char* integer = it;
+		while(it != last && *it == '0')
+			++it;
+		digits.first = it;
+		it = string_parse_decimal(it, last, mantissa, 19);
+		size_t used = (size_t)(it - digits.first);
+		for(; it != last && string_parse_is_digit(*it); ++it)
+			truncated |= *it != '0';
+		size_t count = (size_t)(it - digits.first);
+		bool any_digits = it != integer;
+
+		size_t fraction_length = 0;
+		if(it != last && *it == '.') {
+			const char* fraction = ++it;
+			if(count == 0) {
+				while(it != last && *it == '0')
+					++it;
+				digits.first = it;
+			}
+
+			const char* significant = it;
+			it = string_parse_decimal(it, last, mantissa, count < 19 ? 19 - count : 0);
+			used += (size_t)(it - significant);
+			for(; it != last && string_parse_is_digit(*it); ++it)
+				truncated |= *it != '0';
+			count += (size_t)(it - significant);
+			fraction_length = (size_t)(it - fraction);
+			any_digits |= fraction_length != 0;
+		}
+
+		if(!any_digits)
+			return string_parse_result(first, from_chars_invalid);
+
+		digits.last = it;
+		digits.count = count;
+
+		long long exponent = 0;
+		if(it != last && (*it == 'e' || *it == 'E')) {
+			const char* e = it + 1;
+			const bool e_negative = e != last && *e == '-';
+			if(e != last && (*e == '-' || *e == '+'))
+				++e;
+			if(e != last && string_parse_is_digit(*e)) {
+				for(; e != last && string_parse_is_digit(*e); ++e) {
+					if(exponent < 100000000)
+						exponent = exponent * 10 + (*e - '0');
+				}
+				if(e_negative)
+					exponent = -exponent;
+				it = e;
+			}
+		}
+
+		if(!mantissa) {
+			value = string_parse_make_double(sign);
+			return string_parse_result(it, from_chars_ok);
+		}
+
+		digits.exponent = exponent - (long long)fraction_length;
+		const unsigned long long bits = string_parse_double_bits(mantissa, digits.exponent + (long long)(count - used), truncated, digits);
+		if(bits == 0 || bits == 0x7ffull << 52)
+			return string_parse_result(it, from_chars_out_of_range);
+
+		value = string_parse_make_double(sign | bits);
+		return string_parse_result(it, from_chars_ok);
+	}
+
+	// parses the start of a view, such as a field produced by split()
+	template<typename T>
+	static inline from_chars_result from_chars(string_view text, T& value) {
+		return from_chars(text.data(), text.data() + text.size(), value);
+	}
+
+	template<typename T>
+	static inline from_chars_result from_chars(string_view text, T& value, int base) {
+		return from_chars(text.data(), text.data() + text.size(), value, base);
+	}
+}
+
+#endif
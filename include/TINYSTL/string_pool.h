@@ -0,0 +1,310 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_POOL_H
+#define TINYSTL_STRING_POOL_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
+#include <TINYSTL/vector.h>
+
+namespace tinystl {
+
+	// Stable id of a string interned in a string_pool. Atoms of the same
+	// pool compare and hash as integers; id 0 is the null atom.
+	struct string_atom {
+		unsigned id;
+	};
+
+	static inline bool operator==(string_atom lhs, string_atom rhs) { return lhs.id == rhs.id; }
+	static inline bool operator!=(string_atom lhs, string_atom rhs) { return lhs.id != rhs.id; }
+	static inline bool operator<(string_atom lhs, string_atom rhs) { return lhs.id < rhs.id; }
+
+	static inline size_t hash(const string_atom& value) {
+		return hash(value.id);
+	}
+
+	struct string_pool_slot {
+		size_t hash;
+		size_t id;
+	};
+
+	// header of an arena chunk, followed by the characters
+	struct string_pool_chunk {
+		string_pool_chunk* next;
+		size_t size;
+	};
+
+	// Interns strings into atoms. The characters are copied once into an
+	// arena of large chunks and never move, so views and c_str pointers
+	// stay valid until the pool is cleared or destroyed. An open addressed
+	// table of ids maps the characters back to their atom.
+	template<typename Alloc = TINYSTL_ALLOCATOR>
+	class basic_string_pool {
+	public:
+		basic_string_pool();
+		basic_string_pool(basic_string_pool&& other);
+		~basic_string_pool();
+
+		basic_string_pool& operator=(basic_string_pool&& other);
+
+		size_t size() const;
+		bool empty() const;
+		void clear();
+		void reserve(size_t count);
+
+		string_atom intern(string_view s);
+		string_atom lookup(string_view s) const;
+
+		string_view view(string_atom atom) const;
+		const char* c_str(string_atom atom) const;
+
+		void swap(basic_string_pool& other);
+
+	private:
+		static const size_t c_chunk = 64 * 1024 - sizeof(string_pool_chunk);
+
+		basic_string_pool(const basic_string_pool&) = delete;
+		basic_string_pool& operator=(const basic_string_pool&) = delete;
+
+		size_t find_slot(string_view s, size_t shash) const;
+		void rehash(size_t nslots);
+		char* allocate(size_t len);
+		void free_chunks();
+
+		vector<string_view, Alloc> m_strings;
+		vector<string_pool_slot, Alloc> m_slots;
+		string_pool_chunk* m_chunks;
+		char* m_cursor;
+		char* m_end;
+	};
+
+	template<typename Alloc>
+	inline basic_string_pool<Alloc>::basic_string_pool()
+		: m_chunks(0)
+		, m_cursor(0)
+		, m_end(0)
+	{
+	}
+
+	template<typename Alloc>
+	inline basic_string_pool<Alloc>::basic_string_pool(basic_string_pool&& other)
+		: m_chunks(0)
+		, m_cursor(0)
+		, m_end(0)
+	{
+		swap(other);
+	}
+
+	template<typename Alloc>
+	inline basic_string_pool<Alloc>::~basic_string_pool() {
+		free_chunks();
+	}
+
+	template<typename Alloc>
+	inline basic_string_pool<Alloc>& basic_string_pool<Alloc>::operator=(basic_string_pool&& other) {
+		basic_string_pool(static_cast<basic_string_pool&&>(other)).swap(*this);
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline size_t basic_string_pool<Alloc>::size() const {
+		return m_strings.size();
+	}
+
+	template<typename Alloc>
+	inline bool basic_string_pool<Alloc>::empty() const {
+		return m_strings.empty();
+	}
+
+	template<typename Alloc>
+	inline void basic_string_pool<Alloc>::free_chunks() {
+		for(string_pool_chunk* chunk = m_chunks; chunk; ) {
+			string_pool_chunk* next = chunk->next;
+			Alloc::static_deallocate(chunk, sizeof(string_pool_chunk) + chunk->size);
+			chunk = next;
+		}
+
+		m_chunks = 0;
+		m_cursor = m_end = 0;
+	}
+
+	template<typename Alloc>
+	inline void basic_string_pool<Alloc>::clear() {
+		free_chunks();
+		m_strings.clear();
+
+		const string_pool_slot empty = { 0, 0 };
+		for(string_pool_slot* it = m_slots.begin(), *end = m_slots.end(); it != end; ++it)
+			*it = empty;
+	}
+
+	template<typename Alloc>
+	inline void basic_string_pool<Alloc>::reserve(size_t count) {
+		m_strings.reserve(count);
+
+		size_t nslots = m_slots.size() ? m_slots.size() : 8;
+		while(nslots * 3 < count * 4)
+			nslots *= 2;
+		if(nslots != m_slots.size())
+			rehash(nslots);
+	}
+
+	template<typename Alloc>
+	inline size_t basic_string_pool<Alloc>::find_slot(string_view s, size_t shash) const {
+		const size_t mask = m_slots.size() - 1;
+		for(size_t pos = shash & mask; ; pos = (pos + 1) & mask) {
+			const string_pool_slot& slot = m_slots[pos];
+			if(slot.id == 0)
+				return pos;
+
+			if(slot.hash == shash) {
+				const string_view candidate = m_strings[slot.id - 1];
+				if(candidate.size() == s.size() && string_equal(candidate.data(), s.data(), s.size()))
+					return pos;
+			}
+		}
+	}
+
+	template<typename Alloc>
+	inline void basic_string_pool<Alloc>::rehash(size_t nslots) {
+		const string_pool_slot empty = { 0, 0 };
+		vector<string_pool_slot, Alloc> slots(nslots, empty);
+
+		const size_t mask = nslots - 1;
+		for(const string_pool_slot* it = m_slots.begin(), *end = m_slots.end(); it != end; ++it) {
+			if(it->id == 0)
+				continue;
+
+			size_t pos = it->hash & mask;
+			while(slots[pos].id != 0)
+				pos = (pos + 1) & mask;
+			slots[pos] = *it;
+		}
+
+		m_slots.swap(slots);
+	}
+
+	template<typename Alloc>
+	inline char* basic_string_pool<Alloc>::allocate(size_t len) {
+		if((size_t)(m_end - m_cursor) >= len)
+			return (m_cursor += len) - len;
+
+		// large strings get a chunk of their own behind the current one,
+		// so the space left in the current chunk is not abandoned
+		const size_t size = (len > c_chunk / 4) ? len : c_chunk;
+		string_pool_chunk* chunk = (string_pool_chunk*)Alloc::static_allocate(sizeof(string_pool_chunk) + size);
+		chunk->size = size;
+		char* first = (char*)(chunk + 1);
+
+		if(size == len && m_chunks) {
+			chunk->next = m_chunks->next;
+			m_chunks->next = chunk;
+			return first;
+		}
+
+		chunk->next = m_chunks;
+		m_chunks = chunk;
+		m_cursor = first + len;
+		m_end = first + size;
+		return first;
+	}
+
+	template<typename Alloc>
+	inline string_atom basic_string_pool<Alloc>::intern(string_view s) {
+		const size_t shash = hash(s);
+
+		size_t pos = 0;
+		if(!m_slots.empty()) {
+			pos = find_slot(s, shash);
+			if(m_slots[pos].id != 0) {
+				const string_atom atom = { (unsigned)m_slots[pos].id };
+				return atom;
+			}
+		}
+
+		const size_t id = m_strings.size() + 1;
+		if(m_slots.empty() || id * 4 > m_slots.size() * 3) {
+			rehash(m_slots.empty() ? 8 : m_slots.size() * 2);
+			pos = find_slot(s, shash);
+		}
+
+		char* first = allocate(s.size() + 1);
+		buffer_copy_urange(first, s.data(), s.data() + s.size());
+		first[s.size()] = 0;
+		m_strings.push_back(string_view(first, s.size()));
+
+		m_slots[pos].hash = shash;
+		m_slots[pos].id = id;
+
+		const string_atom atom = { (unsigned)id };
+		return atom;
+	}
+
+	template<typename Alloc>
+	inline string_atom basic_string_pool<Alloc>::lookup(string_view s) const {
+		string_atom atom = { 0 };
+		if(!m_strings.empty())
+			atom.id = (unsigned)m_slots[find_slot(s, hash(s))].id;
+		return atom;
+	}
+
+	template<typename Alloc>
+	inline string_view basic_string_pool<Alloc>::view(string_atom atom) const {
+		return atom.id ? m_strings[atom.id - 1] : string_view();
+	}
+
+	template<typename Alloc>
+	inline const char* basic_string_pool<Alloc>::c_str(string_atom atom) const {
+		return atom.id ? m_strings[atom.id - 1].data() : "";
+	}
+
+	template<typename Alloc>
+	inline void basic_string_pool<Alloc>::swap(basic_string_pool& other) {
+		m_strings.swap(other.m_strings);
+		m_slots.swap(other.m_slots);
+
+		string_pool_chunk* chunks = m_chunks;
+		m_chunks = other.m_chunks;
+		other.m_chunks = chunks;
+
+		char* cursor = m_cursor;
+		m_cursor = other.m_cursor;
+		other.m_cursor = cursor;
+
+		char* end = m_end;
+		m_end = other.m_end;
+		other.m_end = end;
+	}
+
+	typedef basic_string_pool<TINYSTL_ALLOCATOR> string_pool;
+}
+
+#endif
@@ -0,0 +1,199 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_SPLIT_H
+#define TINYSTL_STRING_SPLIT_H
+
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	enum split_mode {
+		// every delimiter ends a field, empty fields included
+		split_mode_fields,
+		// like split_mode_fields, but delimiters inside double quoted fields are skipped
+		split_mode_csv,
+		// '\n' terminated lines with any trailing '\r' removed
+		split_mode_lines,
+	};
+
+	class string_split {
+	public:
+		class iterator {
+		public:
+			iterator();
+
+			string_view operator*() const;
+			iterator& operator++();
+			iterator operator++(int);
+
+			bool operator==(const iterator& other) const;
+			bool operator!=(const iterator& other) const;
+
+		private:
+			iterator(const char* first, const char* end, string_view delims, split_mode mode);
+			void scan(const char* first);
+
+			const char* m_first;
+			const char* m_last;
+			const char* m_next;
+			const char* m_end;
+			string_view m_delims;
+			split_mode m_mode;
+
+			friend class string_split;
+		};
+
+		typedef iterator const_iterator;
+
+		string_split(string_view text, string_view delims, split_mode mode = split_mode_fields);
+
+		iterator begin() const;
+		iterator end() const;
+
+	private:
+		string_view m_text;
+		string_view m_delims;
+		split_mode m_mode;
+	};
+
+	inline string_split::iterator::iterator()
+		: m_first(nullptr)
+		, m_last(nullptr)
+		, m_next(nullptr)
+		, m_end(nullptr)
+		, m_mode(split_mode_fields)
+	{
+	}
+
+	inline string_split::iterator::iterator(const char* first, const char* end, string_view delims, split_mode mode)
+		: m_first(nullptr)
+		, m_last(nullptr)
+		, m_next(nullptr)
+		, m_end(end)
+		, m_delims(delims)
+		, m_mode(mode)
+	{
+		scan(first);
+	}
+
+	inline void string_split::iterator::scan(const char* first) {
+		if(m_mode == split_mode_lines) {
+			if(first == m_end) {
+				m_first = nullptr;
+				return;
+			}
+
+			const char* newline = string_find(first, (size_t)(m_end - first), '\n');
+			m_first = first;
+			m_last = newline ? newline : m_end;
+			m_next = newline ? newline + 1 : m_end;
+			if(m_last != m_first && m_last[-1] == '\r')
+				--m_last;
+			return;
+		}
+
+		const char* it = first;
+		if(m_mode == split_mode_csv && it != m_end && *it == '"') {
+			// skip to the closing quote; "" is an escaped quote
+			for(++it; ; it += 2) {
+				it = string_find(it, (size_t)(m_end - it), '"');
+				if(!it) {
+					it = m_end;
+					break;
+				}
+				if(it + 1 == m_end || it[1] != '"') {
+					++it;
+					break;
+				}
+			}
+		}
+
+		const char* delim = string_find_first_of(it, (size_t)(m_end - it), m_delims.data(), m_delims.size());
+		m_first = first;
+		m_last = delim ? delim : m_end;
+		m_next = delim ? delim + 1 : nullptr;
+	}
+
+	inline string_view string_split::iterator::operator*() const {
+		return string_view(m_first, (size_t)(m_last - m_first));
+	}
+
+	inline string_split::iterator& string_split::iterator::operator++() {
+		if(m_next)
+			scan(m_next);
+		else
+			m_first = nullptr;
+		return *this;
+	}
+
+	inline string_split::iterator string_split::iterator::operator++(int) {
+		iterator temp = *this;
+		++*this;
+		return temp;
+	}
+
+	inline bool string_split::iterator::operator==(const iterator& other) const {
+		return m_first == other.m_first;
+	}
+
+	inline bool string_split::iterator::operator!=(const iterator& other) const {
+		return m_first != other.m_first;
+	}
+
+	inline string_split::string_split(string_view text, string_view delims, split_mode mode)
+		: m_text(text)
+		, m_delims(delims)
+		, m_mode(mode)
+	{
+	}
+
+	inline string_split::iterator string_split::begin() const {
+		if(m_text.empty())
+			return iterator();
+		return iterator(m_text.begin(), m_text.end(), m_delims, m_mode);
+	}
+
+	inline string_split::iterator string_split::end() const {
+		return iterator();
+	}
+
+	static inline string_split split(string_view text, string_view delims) {
+		return string_split(text, delims, split_mode_fields);
+	}
+
+	static inline string_split split_csv(string_view text, string_view delims = ",") {
+		return string_split(text, delims, split_mode_csv);
+	}
+
+	static inline string_split split_lines(string_view text) {
+		return string_split(text, string_view(), split_mode_lines);
+	}
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_SWITCH_H
+#define TINYSTL_STRING_SWITCH_H
+
+#include <TINYSTL/hash.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	// Dispatches on a string with a switch over hashes, so the compiler can
+	// emit a jump table or a binary search instead of a chain of compares:
+	//
+	//	const string_switch cmd(text);
+	//	switch(cmd) {
+	//	case string_case("push"): if(cmd.is("push")) ...; break;
+	//	case string_case("pop"): if(cmd.is("pop")) ...; break;
+	//	}
+	//
+	// Labels are hashed at compile time, and two labels with the same hash
+	// fail to compile as duplicate cases. A different string can still hash
+	// to a label, so a matched case confirms the text with is().
+	static constexpr size_t string_case(string_view label) {
+		return hash_string(label.data(), label.size());
+	}
+
+	class string_switch {
+	public:
+		constexpr explicit string_switch(string_view s);
+
+		constexpr operator size_t() const;
+		constexpr bool is(string_view label) const;
+		constexpr string_view view() const;
+
+	private:
+		string_view m_str;
+		size_t m_hash;
+	};
+
+	constexpr string_switch::string_switch(string_view s)
+		: m_str(s)
+		, m_hash(hash_string(s.data(), s.size()))
+	{
+	}
+
+	constexpr string_switch::operator size_t() const {
+		return m_hash;
+	}
+
+	constexpr bool string_switch::is(string_view label) const {
+		return m_str == label;
+	}
+
+	constexpr string_view string_switch::view() const {
+		return m_str;
+	}
+}
+
+#endif
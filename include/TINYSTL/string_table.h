@@ -0,0 +1,183 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_TABLE_H
+#define TINYSTL_STRING_TABLE_H
+
+#include <TINYSTL/allocator.h>
+#include <TINYSTL/buffer.h>
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string_view.h>
+
+namespace tinystl {
+
+	// Position of a string in a string_table. Handles stay valid as the
+	// table grows; a table holds at most 4GB of characters.
+	struct string_handle {
+		unsigned offset;
+		unsigned length;
+	};
+
+	static inline bool operator==(string_handle lhs, string_handle rhs) { return lhs.offset == rhs.offset && lhs.length == rhs.length; }
+	static inline bool operator!=(string_handle lhs, string_handle rhs) { return !(lhs == rhs); }
+
+	// Append-only storage for many small immutable strings. All characters
+	// are packed back to back in one buffer, and each string is referred to
+	// by an 8 byte handle instead of an owning string object. Views are
+	// invalidated when the table grows, handles are not.
+	template<typename Alloc = TINYSTL_ALLOCATOR>
+	class basic_string_table {
+	public:
+		basic_string_table();
+		basic_string_table(const basic_string_table& other);
+		basic_string_table(basic_string_table&& other);
+		~basic_string_table();
+
+		basic_string_table& operator=(const basic_string_table& other);
+		basic_string_table& operator=(basic_string_table&& other);
+
+		string_handle add(string_view s);
+
+		string_view view(string_handle handle) const;
+		string_view operator[](string_handle handle) const;
+
+		const char* data() const;
+		size_t bytes() const;
+		size_t capacity() const;
+		bool empty() const;
+
+		void reserve(size_t bytes);
+		void clear();
+		void shrink_to_fit();
+
+		void swap(basic_string_table& other);
+
+	private:
+		buffer<char, Alloc> m_buffer;
+	};
+
+	template<typename Alloc>
+	inline basic_string_table<Alloc>::basic_string_table() {
+	}
+
+	template<typename Alloc>
+	inline basic_string_table<Alloc>::basic_string_table(const basic_string_table& other) {
+		buffer_reserve(m_buffer, other.bytes());
+		buffer_insert(m_buffer, m_buffer.last, other.m_buffer.first, other.m_buffer.last);
+	}
+
+	template<typename Alloc>
+	inline basic_string_table<Alloc>::basic_string_table(basic_string_table&& other) {
+		buffer_move(m_buffer, other.m_buffer);
+	}
+
+	template<typename Alloc>
+	inline basic_string_table<Alloc>::~basic_string_table() {
+		buffer_destroy(m_buffer);
+	}
+
+	template<typename Alloc>
+	inline basic_string_table<Alloc>& basic_string_table<Alloc>::operator=(const basic_string_table& other) {
+		basic_string_table(other).swap(*this);
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline basic_string_table<Alloc>& basic_string_table<Alloc>::operator=(basic_string_table&& other) {
+		buffer_destroy(m_buffer);
+		buffer_move(m_buffer, other.m_buffer);
+		return *this;
+	}
+
+	template<typename Alloc>
+	inline string_handle basic_string_table<Alloc>::add(string_view s) {
+		// characters already in the table are referred to rather than copied
+		if(s.data() >= m_buffer.first && s.data() + s.size() <= m_buffer.last && !s.empty()) {
+			const string_handle handle = { (unsigned)(s.data() - m_buffer.first), (unsigned)s.size() };
+			return handle;
+		}
+
+		const string_handle handle = { (unsigned)bytes(), (unsigned)s.size() };
+		buffer_grow_count(m_buffer, s.size());
+		buffer_copy_urange(m_buffer.last, s.data(), s.data() + s.size());
+		m_buffer.last += s.size();
+		return handle;
+	}
+
+	template<typename Alloc>
+	inline string_view basic_string_table<Alloc>::view(string_handle handle) const {
+		return string_view(m_buffer.first + handle.offset, handle.length);
+	}
+
+	template<typename Alloc>
+	inline string_view basic_string_table<Alloc>::operator[](string_handle handle) const {
+		return string_view(m_buffer.first + handle.offset, handle.length);
+	}
+
+	template<typename Alloc>
+	inline const char* basic_string_table<Alloc>::data() const {
+		return m_buffer.first;
+	}
+
+	template<typename Alloc>
+	inline size_t basic_string_table<Alloc>::bytes() const {
+		return (size_t)(m_buffer.last - m_buffer.first);
+	}
+
+	template<typename Alloc>
+	inline size_t basic_string_table<Alloc>::capacity() const {
+		return (size_t)(m_buffer.capacity - m_buffer.first);
+	}
+
+	template<typename Alloc>
+	inline bool basic_string_table<Alloc>::empty() const {
+		return m_buffer.last == m_buffer.first;
+	}
+
+	template<typename Alloc>
+	inline void basic_string_table<Alloc>::reserve(size_t bytes) {
+		buffer_reserve(m_buffer, bytes);
+	}
+
+	template<typename Alloc>
+	inline void basic_string_table<Alloc>::clear() {
+		buffer_clear(m_buffer);
+	}
+
+	template<typename Alloc>
+	inline void basic_string_table<Alloc>::shrink_to_fit() {
+		buffer_shrink_to_fit(m_buffer);
+	}
+
+	template<typename Alloc>
+	inline void basic_string_table<Alloc>::swap(basic_string_table& other) {
+		buffer_swap(m_buffer, other.m_buffer);
+	}
+
+	typedef basic_string_table<TINYSTL_ALLOCATOR> string_table;
+}
+
+#endif
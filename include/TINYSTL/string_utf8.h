@@ -0,0 +1,468 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_UTF8_H
+#define TINYSTL_STRING_UTF8_H
+
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_base.h>
+#include <TINYSTL/string_view.h>
+#include <TINYSTL/vector.h>
+
+// the validator's nibble lookups need a byte shuffle, SSSE3 or better
+#if TINYSTL_STRING_SIMD == 32
+#	define TINYSTL_STRING_UTF8_SIMD 32
+#elif TINYSTL_STRING_SIMD == 16 && defined(__SSSE3__)
+#	include <tmmintrin.h>
+#	define TINYSTL_STRING_UTF8_SIMD 16
+#endif
+
+namespace tinystl {
+
+	// Decodes the sequence at s, which has count bytes available. Returns
+	// its length, or 0 for overlong forms, surrogates, values past
+	// U+10FFFF and truncated or stray continuation bytes.
+	static inline size_t string_utf8_decode(const unsigned char* s, size_t count, unsigned& cp) {
+		const unsigned c = s[0];
+		if(c < 0x80) {
+			cp = c;
+			return 1;
+		}
+
+		if(c < 0xc2)
+			return 0;
+
+		if(c < 0xe0) {
+			if(count < 2 || (s[1] & 0xc0) != 0x80)
+				return 0;
+			cp = ((c & 0x1f) << 6) | (s[1] & 0x3f);
+			return 2;
+		}
+
+		if(c < 0xf0) {
+			const unsigned low = c == 0xe0 ? 0xa0 : 0x80;
+			const unsigned high = c == 0xed ? 0x9f : 0xbf;
+			if(count < 3 || s[1] < low || s[1] > high || (s[2] & 0xc0) != 0x80)
+				return 0;
+			cp = ((c & 0x0f) << 12) | ((s[1] & 0x3f) << 6) | (s[2] & 0x3f);
+			return 3;
+		}
+
+		if(c < 0xf5) {
+			const unsigned low = c == 0xf0 ? 0x90 : 0x80;
+			const unsigned high = c == 0xf4 ? 0x8f : 0xbf;
+			if(count < 4 || s[1] < low || s[1] > high || (s[2] & 0xc0) != 0x80 || (s[3] & 0xc0) != 0x80)
+				return 0;
+			cp = ((c & 0x07) << 18) | ((s[1] & 0x3f) << 12) | ((s[2] & 0x3f) << 6) | (s[3] & 0x3f);
+			return 4;
+		}
+
+		return 0;
+	}
+
+	static inline bool string_utf8_validate_scalar(const char* s, size_t count) {
+		const unsigned char* it = (const unsigned char*)s;
+		const unsigned char* last = it + count;
+		while(it != last) {
+			// skip ascii a word at a time
+			if(last - it >= 8) {
+				unsigned long long word;
+				string_copy((char*)&word, (const char*)it, sizeof(word));
+				if(!(word & 0x8080808080808080ull)) {
+					it += 8;
+					continue;
+				}
+			}
+
+			unsigned cp;
+			const size_t len = string_utf8_decode(it, (size_t)(last - it), cp);
+			if(!len)
+				return false;
+			it += len;
+		}
+		return true;
+	}
+
+#if defined(TINYSTL_STRING_UTF8_SIMD)
+	// Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction
+	// Per Byte". Each byte and its predecessor select error classes from
+	// three nibble tables; a valid pair has no class in common.
+
+	enum {
+		c_string_utf8_too_short = 1 << 0,
+		c_string_utf8_too_long = 1 << 1,
+		c_string_utf8_overlong_3 = 1 << 2,
+		c_string_utf8_too_large = 1 << 3,
+		c_string_utf8_surrogate = 1 << 4,
+		c_string_utf8_overlong_2 = 1 << 5,
+		c_string_utf8_too_large_1000 = 1 << 6,
+		c_string_utf8_overlong_4 = 1 << 6,
+		c_string_utf8_two_conts = 1 << 7,
+		c_string_utf8_carry = c_string_utf8_too_short | c_string_utf8_too_long | c_string_utf8_two_conts,
+	};
+
+#	if TINYSTL_STRING_UTF8_SIMD == 32
+	typedef __m256i string_utf8_simd;
+
+	static inline string_utf8_simd string_utf8_table(const char* table) {
+		return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)table));
+	}
+
+	static inline string_utf8_simd string_utf8_splat(char c) {
+		return _mm256_set1_epi8(c);
+	}
+
+	static inline string_utf8_simd string_utf8_load(const char* p) {
+		return _mm256_loadu_si256((const __m256i*)p);
+	}
+
+	static inline string_utf8_simd string_utf8_zero() {
+		return _mm256_setzero_si256();
+	}
+
+	static inline string_utf8_simd string_utf8_and(string_utf8_simd a, string_utf8_simd b) {
+		return _mm256_and_si256(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_or(string_utf8_simd a, string_utf8_simd b) {
+		return _mm256_or_si256(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_xor(string_utf8_simd a, string_utf8_simd b) {
+		return _mm256_xor_si256(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_subs(string_utf8_simd a, string_utf8_simd b) {
+		return _mm256_subs_epu8(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_lookup(string_utf8_simd table, string_utf8_simd nibbles) {
+		return _mm256_shuffle_epi8(table, nibbles);
+	}
+
+	static inline string_utf8_simd string_utf8_high_nibbles(string_utf8_simd v) {
+		return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+	}
+
+	static inline string_utf8_simd string_utf8_low_nibbles(string_utf8_simd v) {
+		return _mm256_and_si256(v, _mm256_set1_epi8(0x0f));
+	}
+
+	// the block shifted by n bytes, filled from the end of the previous block
+	static inline string_utf8_simd string_utf8_prev1(string_utf8_simd v, string_utf8_simd prev) {
+		return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(prev, v, 0x21), 15);
+	}
+
+	static inline string_utf8_simd string_utf8_prev2(string_utf8_simd v, string_utf8_simd prev) {
+		return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(prev, v, 0x21), 14);
+	}
+
+	static inline string_utf8_simd string_utf8_prev3(string_utf8_simd v, string_utf8_simd prev) {
+		return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(prev, v, 0x21), 13);
+	}
+
+	static inline bool string_utf8_is_ascii(string_utf8_simd v) {
+		return _mm256_movemask_epi8(v) == 0;
+	}
+
+	static inline bool string_utf8_any(string_utf8_simd v) {
+		return !_mm256_testz_si256(v, v);
+	}
+#	else
+	typedef __m128i string_utf8_simd;
+
+	static inline string_utf8_simd string_utf8_table(const char* table) {
+		return _mm_loadu_si128((const __m128i*)table);
+	}
+
+	static inline string_utf8_simd string_utf8_splat(char c) {
+		return _mm_set1_epi8(c);
+	}
+
+	static inline string_utf8_simd string_utf8_load(const char* p) {
+		return _mm_loadu_si128((const __m128i*)p);
+	}
+
+	static inline string_utf8_simd string_utf8_zero() {
+		return _mm_setzero_si128();
+	}
+
+	static inline string_utf8_simd string_utf8_and(string_utf8_simd a, string_utf8_simd b) {
+		return _mm_and_si128(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_or(string_utf8_simd a, string_utf8_simd b) {
+		return _mm_or_si128(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_xor(string_utf8_simd a, string_utf8_simd b) {
+		return _mm_xor_si128(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_subs(string_utf8_simd a, string_utf8_simd b) {
+		return _mm_subs_epu8(a, b);
+	}
+
+	static inline string_utf8_simd string_utf8_lookup(string_utf8_simd table, string_utf8_simd nibbles) {
+		return _mm_shuffle_epi8(table, nibbles);
+	}
+
+	static inline string_utf8_simd string_utf8_high_nibbles(string_utf8_simd v) {
+		return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+	}
+
+	static inline string_utf8_simd string_utf8_low_nibbles(string_utf8_simd v) {
+		return _mm_and_si128(v, _mm_set1_epi8(0x0f));
+	}
+
+	// the block shifted by n bytes, filled from the end of the previous block
+	static inline string_utf8_simd string_utf8_prev1(string_utf8_simd v, string_utf8_simd prev) {
+		return _mm_alignr_epi8(v, prev, 15);
+	}
+
+	static inline string_utf8_simd string_utf8_prev2(string_utf8_simd v, string_utf8_simd prev) {
+		return _mm_alignr_epi8(v, prev, 14);
+	}
+
+	static inline string_utf8_simd string_utf8_prev3(string_utf8_simd v, string_utf8_simd prev) {
+		return _mm_alignr_epi8(v, prev, 13);
+	}
+
+	static inline bool string_utf8_is_ascii(string_utf8_simd v) {
+		return _mm_movemask_epi8(v) == 0;
+	}
+
+	static inline bool string_utf8_any(string_utf8_simd v) {
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xffff;
+	}
+#	endif
+
+	static inline void string_utf8_check_block(string_utf8_simd input, string_utf8_simd& prev_input, string_utf8_simd& prev_incomplete, string_utf8_simd& error) {
+		static const char c_byte1_high[16] = {
+			c_string_utf8_too_long, c_string_utf8_too_long, c_string_utf8_too_long, c_string_utf8_too_long,
+			c_string_utf8_too_long, c_string_utf8_too_long, c_string_utf8_too_long, c_string_utf8_too_long,
+			(char)c_string_utf8_two_conts, (char)c_string_utf8_two_conts, (char)c_string_utf8_two_conts, (char)c_string_utf8_two_conts,
+			c_string_utf8_too_short | c_string_utf8_overlong_2,
+			c_string_utf8_too_short,
+			c_string_utf8_too_short | c_string_utf8_overlong_3 | c_string_utf8_surrogate,
+			c_string_utf8_too_short | c_string_utf8_too_large | c_string_utf8_too_large_1000 | c_string_utf8_overlong_4,
+		};
+		static const char c_byte1_low[16] = {
+			(char)(c_string_utf8_carry | c_string_utf8_overlong_3 | c_string_utf8_overlong_2 | c_string_utf8_overlong_4),
+			(char)(c_string_utf8_carry | c_string_utf8_overlong_2),
+			(char)c_string_utf8_carry,
+			(char)c_string_utf8_carry,
+			(char)(c_string_utf8_carry | c_string_utf8_too_large),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000 | c_string_utf8_surrogate),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+			(char)(c_string_utf8_carry | c_string_utf8_too_large | c_string_utf8_too_large_1000),
+		};
+		static const char c_byte2_high[16] = {
+			c_string_utf8_too_short, c_string_utf8_too_short, c_string_utf8_too_short, c_string_utf8_too_short,
+			c_string_utf8_too_short, c_string_utf8_too_short, c_string_utf8_too_short, c_string_utf8_too_short,
+			(char)(c_string_utf8_too_long | c_string_utf8_overlong_2 | c_string_utf8_two_conts | c_string_utf8_overlong_3 | c_string_utf8_too_large_1000 | c_string_utf8_overlong_4),
+			(char)(c_string_utf8_too_long | c_string_utf8_overlong_2 | c_string_utf8_two_conts | c_string_utf8_overlong_3 | c_string_utf8_too_large),
+			(char)(c_string_utf8_too_long | c_string_utf8_overlong_2 | c_string_utf8_two_conts | c_string_utf8_surrogate | c_string_utf8_too_large),
+			(char)(c_string_utf8_too_long | c_string_utf8_overlong_2 | c_string_utf8_two_conts | c_string_utf8_surrogate | c_string_utf8_too_large),
+			c_string_utf8_too_short, c_string_utf8_too_short, c_string_utf8_too_short, c_string_utf8_too_short,
+		};
+		// a lead byte in the last three positions still needs continuation bytes
+		static const unsigned char c_incomplete[32] = {
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf,
+		};
+
+		if(string_utf8_is_ascii(input)) {
+			error = string_utf8_or(error, prev_incomplete);
+			prev_input = input;
+			return;
+		}
+
+		const string_utf8_simd prev1 = string_utf8_prev1(input, prev_input);
+		const string_utf8_simd special = string_utf8_and(string_utf8_and(
+			string_utf8_lookup(string_utf8_table(c_byte1_high), string_utf8_high_nibbles(prev1)),
+			string_utf8_lookup(string_utf8_table(c_byte1_low), string_utf8_low_nibbles(prev1))),
+			string_utf8_lookup(string_utf8_table(c_byte2_high), string_utf8_high_nibbles(input)));
+
+		// the third and fourth bytes of a sequence must be continuations, the two_conts class marks them
+		const string_utf8_simd third = string_utf8_subs(string_utf8_prev2(input, prev_input), string_utf8_splat('\x60'));
+		const string_utf8_simd fourth = string_utf8_subs(string_utf8_prev3(input, prev_input), string_utf8_splat('\x70'));
+		const string_utf8_simd must_continue = string_utf8_and(string_utf8_or(third, fourth), string_utf8_splat('\x80'));
+
+		error = string_utf8_or(error, string_utf8_xor(must_continue, special));
+		prev_incomplete = string_utf8_subs(input, string_utf8_load((const char*)c_incomplete + 32 - TINYSTL_STRING_UTF8_SIMD));
+		prev_input = input;
+	}
+
+	static inline bool string_utf8_validate(const char* s, size_t count) {
+		string_utf8_simd prev_input = string_utf8_zero();
+		string_utf8_simd prev_incomplete = string_utf8_zero();
+		string_utf8_simd error = string_utf8_zero();
+
+		size_t pos = 0;
+		for(; pos + TINYSTL_STRING_UTF8_SIMD <= count; pos += TINYSTL_STRING_UTF8_SIMD)
+			string_utf8_check_block(string_utf8_load(s + pos), prev_input, prev_incomplete, error);
+
+		// the zero padding after a short tail is ascii, which flags anything left incomplete
+		if(pos < count) {
+			char tail[TINYSTL_STRING_UTF8_SIMD] = {};
+			string_copy(tail, s + pos, count - pos);
+			string_utf8_check_block(string_utf8_load(tail), prev_input, prev_incomplete, error);
+		}
+
+		return !string_utf8_any(string_utf8_or(error, prev_incomplete));
+	}
+#else
+	static inline bool string_utf8_validate(const char* s, size_t count) {
+		return string_utf8_validate_scalar(s, count);
+	}
+#endif
+
+	static inline bool utf8_validate(string_view text) {
+		return string_utf8_validate(text.data(), text.size());
+	}
+
+	// Appends the UTF-16 form of text to out. Returns false, leaving out
+	// unchanged, when text is not valid UTF-8.
+	template<typename Alloc>
+	static inline bool utf8_to_utf16(string_view text, vector<char16_t, Alloc>& out) {
+		const size_t original = out.size();
+		out.reserve(original + text.size());
+
+		const unsigned char* it = (const unsigned char*)text.data();
+		const unsigned char* last = it + text.size();
+		char16_t chunk[256];
+		size_t used = 0;
+		while(it != last) {
+			if(used > 256 - 16) {
+				out.insert(out.end(), chunk, chunk + used);
+				used = 0;
+			}
+
+#if defined(TINYSTL_STRING_SIMD)
+			// widen runs of ascii sixteen at a time
+			if(last - it >= 16) {
+				const __m128i block = _mm_loadu_si128((const __m128i*)it);
+				if(!_mm_movemask_epi8(block)) {
+					_mm_storeu_si128((__m128i*)(chunk + used), _mm_unpacklo_epi8(block, _mm_setzero_si128()));
+					_mm_storeu_si128((__m128i*)(chunk + used + 8), _mm_unpackhi_epi8(block, _mm_setzero_si128()));
+					it += 16;
+					used += 16;
+					continue;
+				}
+			}
+#endif
+
+			unsigned cp;
+			const size_t len = string_utf8_decode(it, (size_t)(last - it), cp);
+			if(!len) {
+				out.resize(original);
+				return false;
+			}
+			it += len;
+
+			if(cp < 0x10000) {
+				chunk[used++] = (char16_t)cp;
+			} else {
+				cp -= 0x10000;
+				chunk[used++] = (char16_t)(0xd800 + (cp >> 10));
+				chunk[used++] = (char16_t)(0xdc00 + (cp & 0x3ff));
+			}
+		}
+
+		out.insert(out.end(), chunk, chunk + used);
+		return true;
+	}
+
+	// Appends the UTF-8 form of [first, last) to out. Returns false,
+	// leaving out unchanged, on an unpaired surrogate.
+	template<typename Alloc, size_t N>
+	static inline bool utf16_to_utf8(const char16_t* first, const char16_t* last, basic_string<Alloc, N>& out) {
+		const size_t original = out.size();
+
+		char chunk[256];
+		size_t used = 0;
+		while(first != last) {
+			if(used > 256 - 8) {
+				out.append(chunk, chunk + used);
+				used = 0;
+			}
+
+#if defined(TINYSTL_STRING_SIMD)
+			// narrow runs of ascii eight at a time
+			if(last - first >= 8) {
+				const __m128i block = _mm_loadu_si128((const __m128i*)first);
+				const __m128i high = _mm_and_si128(block, _mm_set1_epi16((short)0xff80));
+				if(_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xffff) {
+					_mm_storel_epi64((__m128i*)(chunk + used), _mm_packus_epi16(block, block));
+					first += 8;
+					used += 8;
+					continue;
+				}
+			}
+#endif
+
+			unsigned cp = *first++;
+			if(cp >= 0xd800 && cp < 0xe000) {
+				if(cp >= 0xdc00 || first == last || *first < 0xdc00 || *first >= 0xe000) {
+					out.resize(original);
+					return false;
+				}
+				cp = 0x10000 + ((cp - 0xd800) << 10) + (*first++ - 0xdc00);
+			}
+
+			if(cp < 0x80) {
+				chunk[used++] = (char)cp;
+			} else if(cp < 0x800) {
+				chunk[used++] = (char)(0xc0 | (cp >> 6));
+				chunk[used++] = (char)(0x80 | (cp & 0x3f));
+			} else if(cp < 0x10000) {
+				chunk[used++] = (char)(0xe0 | (cp >> 12));
+				chunk[used++] = (char)(0x80 | ((cp >> 6) & 0x3f));
+				chunk[used++] = (char)(0x80 | (cp & 0x3f));
+			} else {
+				chunk[used++] = (char)(0xf0 | (cp >> 18));
+				chunk[used++] = (char)(0x80 | ((cp >> 12) & 0x3f));
+				chunk[used++] = (char)(0x80 | ((cp >> 6) & 0x3f));
+				chunk[used++] = (char)(0x80 | (cp & 0x3f));
+			}
+		}
+
+		out.append(chunk, chunk + used);
+		return true;
+	}
+}
+
+#endif
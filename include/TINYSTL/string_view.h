@@ -1,147 +1,303 @@
-/*-
- * Copyright 2012-1017 Matthew Endsley
- * All rights reserved
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted providing that the following conditions
- * are met:
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
- * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
- * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
- * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
- * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
- * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
- * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
- * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- * POSSIBILITY OF SUCH DAMAGE.
- */
-
-#ifndef TINYSTL_STRING_VIEW_H
-#define TINYSTL_STRING_VIEW_H
-
-#include <TINYSTL/stddef.h>
-
-namespace tinystl {
-
-	class string_view
-	{
-	public:
-		typedef char value_type;
-		typedef char* pointer;
-		typedef const char* const_pointer;
-		typedef char& reference;
-		typedef const char& const_reference;
-		typedef const_pointer iterator;
-		typedef const_pointer const_iterator;
-		typedef size_t size_type;
-		typedef ptrdiff_t difference_type;
-
-		static constexpr size_type npos = size_type(-1);
-
-		constexpr string_view();
-		constexpr string_view(const char* s, size_type count);
-		constexpr string_view(const char* s);
-		constexpr string_view(const string_view&) = default;
-		string_view& operator=(const string_view&) = default;
-
-		constexpr const char* data() const;
-		constexpr char operator[](size_type pos) const;
-		constexpr size_type size() const;
-		constexpr bool empty() const;
-		constexpr iterator begin() const;
-		constexpr const_iterator cbegin() const;
-		constexpr iterator end() const;
-		constexpr const_iterator cend() const;
-		constexpr string_view substr(size_type pos = 0, size_type count = npos) const;
-		constexpr void swap(string_view& v);
-
-	private:
-		string_view(decltype(nullptr)) = delete;
-
-		static constexpr size_type strlen(const char*);
-
-		const char* m_str;
-		size_type m_size;
-	};
-
-	constexpr string_view::string_view()
-		: m_str(nullptr)
-		, m_size(0)
-	{
-	}
-
-	constexpr string_view::string_view(const char* s, size_type count)
-		: m_str(s)
-		, m_size(count)
-	{
-	}
-
-	constexpr string_view::string_view(const char* s)
-		: m_str(s)
-		, m_size(strlen(s))
-	{
-	}
-
-	constexpr const char* string_view::data() const {
-		return m_str;
-	}
-
-	constexpr char string_view::operator[](size_type pos) const {
-		return m_str[pos];
-	}
-
-	constexpr string_view::size_type string_view::size() const {
-		return m_size;
-	}
-
-	constexpr bool string_view::empty() const {
-    	return 0 == m_size;
-	}
-
-	constexpr string_view::iterator string_view::begin() const {
-		return m_str;
-	}
-
-	constexpr string_view::const_iterator string_view::cbegin() const {
-		return m_str;
-	}
-
-	constexpr string_view::iterator string_view::end() const {
-		return m_str + m_size;
-	}
-
-	constexpr string_view::const_iterator string_view::cend() const {
-		return m_str + m_size;
-	}
-
-	constexpr string_view string_view::substr(size_type pos, size_type count) const {
-		return string_view(m_str + pos, npos == count ? m_size - pos : count);
-	}
-
-	constexpr void string_view::swap(string_view& v) {
-		const char* strtmp = m_str;
-		size_type sizetmp = m_size;
-		m_str = v.m_str;
-		m_size = v.m_size;
-		v.m_str = strtmp;
-		v.m_size = sizetmp;
-	}
-
-	constexpr string_view::size_type string_view::strlen(const char* s) {
-		for (size_t len = 0; ; ++len) {
-			if (0 == s[len]) {
-				return len;
-			}
-		}
-	}
-}
-
-#endif // TINYSTL_STRING_VIEW_H
+/*-
+ * Copyright 2012-1017 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_STRING_VIEW_H
+#define TINYSTL_STRING_VIEW_H
+
+#include <TINYSTL/stddef.h>
+#include <TINYSTL/hash.h>
+#include <TINYSTL/string_base.h>
+
+namespace tinystl {
+
+	class string_view
+	{
+	public:
+		typedef char value_type;
+		typedef char* pointer;
+		typedef const char* const_pointer;
+		typedef char& reference;
+		typedef const char& const_reference;
+		typedef const_pointer iterator;
+		typedef const_pointer const_iterator;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		static constexpr size_type npos = size_type(-1);
+
+		constexpr string_view();
+		constexpr string_view(const char* s, size_type count);
+		constexpr string_view(const char* s);
+		constexpr string_view(const string_view&) = default;
+		string_view& operator=(const string_view&) = default;
+
+		constexpr const char* data() const;
+		constexpr char operator[](size_type pos) const;
+		constexpr size_type size() const;
+		constexpr bool empty() const;
+		constexpr iterator begin() const;
+		constexpr const_iterator cbegin() const;
+		constexpr iterator end() const;
+		constexpr const_iterator cend() const;
+		constexpr char front() const;
+		constexpr char back() const;
+		constexpr string_view substr(size_type pos = 0, size_type count = npos) const;
+		constexpr void swap(string_view& v);
+
+		constexpr void remove_prefix(size_type n);
+		constexpr void remove_suffix(size_type n);
+
+		constexpr int compare(string_view v) const;
+		constexpr bool starts_with(string_view v) const;
+		constexpr bool starts_with(char c) const;
+		constexpr bool ends_with(string_view v) const;
+		constexpr bool ends_with(char c) const;
+		constexpr bool contains(string_view v) const;
+		constexpr bool contains(char c) const;
+
+		constexpr size_type find(string_view v, size_type pos = 0) const;
+		constexpr size_type find(char c, size_type pos = 0) const;
+		constexpr size_type rfind(string_view v, size_type pos = npos) const;
+		constexpr size_type rfind(char c, size_type pos = npos) const;
+		constexpr size_type find_first_of(string_view v, size_type pos = 0) const;
+		constexpr size_type find_first_of(char c, size_type pos = 0) const;
+		constexpr size_type find_last_of(string_view v, size_type pos = npos) const;
+		constexpr size_type find_last_of(char c, size_type pos = npos) const;
+
+	private:
+		string_view(decltype(nullptr)) = delete;
+
+		static constexpr size_type strlen(const char*);
+
+		const char* m_str;
+		size_type m_size;
+	};
+
+	constexpr string_view::string_view()
+		: m_str(nullptr)
+		, m_size(0)
+	{
+	}
+
+	constexpr string_view::string_view(const char* s, size_type count)
+		: m_str(s)
+		, m_size(count)
+	{
+	}
+
+	constexpr string_view::string_view(const char* s)
+		: m_str(s)
+		, m_size(strlen(s))
+	{
+	}
+
+	constexpr const char* string_view::data() const {
+		return m_str;
+	}
+
+	constexpr char string_view::operator[](size_type pos) const {
+		return m_str[pos];
+	}
+
+	constexpr string_view::size_type string_view::size() const {
+		return m_size;
+	}
+
+	constexpr bool string_view::empty() const {
+    	return 0 == m_size;
+	}
+
+	constexpr string_view::iterator string_view::begin() const {
+		return m_str;
+	}
+
+	constexpr string_view::const_iterator string_view::cbegin() const {
+		return m_str;
+	}
+
+	constexpr string_view::iterator string_view::end() const {
+		return m_str + m_size;
+	}
+
+	constexpr string_view::const_iterator string_view::cend() const {
+		return m_str + m_size;
+	}
+
+	constexpr char string_view::front() const {
+		return m_str[0];
+	}
+
+	constexpr char string_view::back() const {
+		return m_str[m_size - 1];
+	}
+
+	constexpr string_view string_view::substr(size_type pos, size_type count) const {
+		return string_view(m_str + pos, npos == count ? m_size - pos : count);
+	}
+
+	constexpr void string_view::swap(string_view& v) {
+		const char* strtmp = m_str;
+		size_type sizetmp = m_size;
+		m_str = v.m_str;
+		m_size = v.m_size;
+		v.m_str = strtmp;
+		v.m_size = sizetmp;
+	}
+
+	constexpr void string_view::remove_prefix(size_type n) {
+		m_str += n;
+		m_size -= n;
+	}
+
+	constexpr void string_view::remove_suffix(size_type n) {
+		m_size -= n;
+	}
+
+	constexpr int string_view::compare(string_view v) const {
+		const size_type count = m_size < v.m_size ? m_size : v.m_size;
+		const int result = TINYSTL_STRING_KERNEL(string_compare, m_str, v.m_str, count);
+		if(result != 0) return result;
+
+		if(m_size < v.m_size) return -1;
+		if(m_size > v.m_size) return 1;
+		return 0;
+	}
+
+	constexpr bool string_view::starts_with(string_view v) const {
+		return v.m_size <= m_size && TINYSTL_STRING_KERNEL(string_equal, m_str, v.m_str, v.m_size);
+	}
+
+	constexpr bool string_view::starts_with(char c) const {
+		return m_size != 0 && m_str[0] == c;
+	}
+
+	constexpr bool string_view::ends_with(string_view v) const {
+		return v.m_size <= m_size && TINYSTL_STRING_KERNEL(string_equal, m_str + m_size - v.m_size, v.m_str, v.m_size);
+	}
+
+	constexpr bool string_view::ends_with(char c) const {
+		return m_size != 0 && m_str[m_size - 1] == c;
+	}
+
+	constexpr bool string_view::contains(string_view v) const {
+		return find(v) != npos;
+	}
+
+	constexpr bool string_view::contains(char c) const {
+		return find(c) != npos;
+	}
+
+	constexpr string_view::size_type string_view::find(string_view v, size_type pos) const {
+		if(pos > m_size)
+			return npos;
+		if(v.m_size == 0)
+			return pos;
+
+		const char* match = TINYSTL_STRING_KERNEL(string_search, m_str + pos, m_size - pos, v.m_str, v.m_size);
+		return match ? size_type(match - m_str) : npos;
+	}
+
+	constexpr string_view::size_type string_view::find(char c, size_type pos) const {
+		if(pos >= m_size)
+			return npos;
+
+		const char* match = TINYSTL_STRING_KERNEL(string_find, m_str + pos, m_size - pos, c);
+		return match ? size_type(match - m_str) : npos;
+	}
+
+	constexpr string_view::size_type string_view::rfind(string_view v, size_type pos) const {
+		if(v.m_size > m_size)
+			return npos;
+		if(v.m_size == 0)
+			return pos < m_size ? pos : m_size;
+
+		const size_type last_possible = pos < m_size - v.m_size ? pos : m_size - v.m_size;
+		const char* match = TINYSTL_STRING_KERNEL(string_rsearch, m_str, last_possible + v.m_size, v.m_str, v.m_size);
+		return match ? size_type(match - m_str) : npos;
+	}
+
+	constexpr string_view::size_type string_view::rfind(char c, size_type pos) const {
+		if(m_size == 0)
+			return npos;
+
+		const size_type count = (pos < m_size - 1 ? pos : m_size - 1) + 1;
+		const char* match = TINYSTL_STRING_KERNEL(string_rfind, m_str, count, c);
+		return match ? size_type(match - m_str) : npos;
+	}
+
+	constexpr string_view::size_type string_view::find_first_of(string_view v, size_type pos) const {
+		if(pos >= m_size)
+			return npos;
+
+		const char* match = TINYSTL_STRING_KERNEL(string_find_first_of, m_str + pos, m_size - pos, v.m_str, v.m_size);
+		return match ? size_type(match - m_str) : npos;
+	}
+
+	constexpr string_view::size_type string_view::find_first_of(char c, size_type pos) const {
+		return find(c, pos);
+	}
+
+	constexpr string_view::size_type string_view::find_last_of(string_view v, size_type pos) const {
+		if(m_size == 0)
+			return npos;
+
+		const size_type count = (pos < m_size - 1 ? pos : m_size - 1) + 1;
+		const char* match = TINYSTL_STRING_KERNEL(string_find_last_of, m_str, count, v.m_str, v.m_size);
+		return match ? size_type(match - m_str) : npos;
+	}
+
+	constexpr string_view::size_type string_view::find_last_of(char c, size_type pos) const {
+		return rfind(c, pos);
+	}
+
+	constexpr string_view::size_type string_view::strlen(const char* s) {
+#if defined(TINYSTL_IS_CONSTANT_EVALUATED)
+		if(!TINYSTL_IS_CONSTANT_EVALUATED())
+			return string_length(s);
+#endif
+		return string_length_scalar(s);
+	}
+
+	constexpr bool operator==(string_view lhs, string_view rhs) {
+		return lhs.size() == rhs.size() && TINYSTL_STRING_KERNEL(string_equal, lhs.data(), rhs.data(), lhs.size());
+	}
+
+	constexpr bool operator!=(string_view lhs, string_view rhs) { return !(lhs == rhs); }
+
+	constexpr bool operator<(string_view lhs, string_view rhs) { return lhs.compare(rhs) < 0; }
+
+	constexpr bool operator<=(string_view lhs, string_view rhs) { return lhs.compare(rhs) <= 0; }
+
+	constexpr bool operator>(string_view lhs, string_view rhs) { return lhs.compare(rhs) > 0; }
+
+	constexpr bool operator>=(string_view lhs, string_view rhs) { return lhs.compare(rhs) >= 0; }
+
+	static constexpr size_t hash(const string_view& value) {
+		return hash_string(value.data(), value.size());
+	}
+}
+
+#endif // TINYSTL_STRING_VIEW_H
@@ -46,6 +46,7 @@ namespace tinystl {
 		unordered_map& operator=(unordered_map&& other);
 
 		typedef pair<Key, Value> value_type;
+		typedef unordered_hash_node_handle<Key, Value, Alloc> node_type;
 
 		typedef unordered_hash_iterator<const unordered_hash_node<Key, Value> > const_iterator;
 		typedef unordered_hash_iterator<unordered_hash_node<Key, Value> > iterator;
@@ -67,6 +68,13 @@ namespace tinystl {
 		pair<iterator, bool> emplace(pair<Key, Value>&& p);
 		void erase(const_iterator where);
 		void erase(const Key& key);
+		template<typename Predicate>
+		size_t erase_if(Predicate pred);
+
+		node_type extract(const_iterator where);
+		node_type extract(const Key& key);
+		pair<iterator, bool> insert(node_type&& node);
+		void merge(unordered_map& other);
 
 		Value& operator[](const Key& key);
 
@@ -75,6 +83,7 @@ namespace tinystl {
 	private:
 
 		void rehash(size_t nbuckets);
+		void init_buckets();
 
 		typedef unordered_hash_node<Key, Value>* pointer;
 
@@ -86,13 +95,15 @@ namespace tinystl {
 	inline unordered_map<Key, Value, Alloc>::unordered_map()
 		: m_size(0)
 	{
-		buffer_resize<pointer, Alloc>(m_buckets, 9, 0);
 	}
 
 	template<typename Key, typename Value, typename Alloc>
 	inline unordered_map<Key, Value, Alloc>::unordered_map(const unordered_map& other)
 		: m_size(other.m_size)
 	{
+		if (other.m_buckets.first == other.m_buckets.last)
+			return;
+
 		const size_t nbuckets = (size_t)(other.m_buckets.last - other.m_buckets.first);
 		buffer_resize<pointer, Alloc>(m_buckets, nbuckets, 0);
 
@@ -134,7 +145,7 @@ namespace tinystl {
 	template<typename Key, typename Value, typename Alloc>
 	inline typename unordered_map<Key, Value, Alloc>::iterator unordered_map<Key, Value, Alloc>::begin() {
 		iterator it;
-		it.node = *m_buckets.first;
+		it.node = (m_buckets.first != m_buckets.last) ? *m_buckets.first : 0;
 		return it;
 	}
 
@@ -148,7 +159,7 @@ namespace tinystl {
 	template<typename Key, typename Value, typename Alloc>
 	inline typename unordered_map<Key, Value, Alloc>::const_iterator unordered_map<Key, Value, Alloc>::begin() const {
 		const_iterator cit;
-		cit.node = *m_buckets.first;
+		cit.node = (m_buckets.first != m_buckets.last) ? *m_buckets.first : 0;
 		return cit;
 	}
 
@@ -171,6 +182,9 @@ namespace tinystl {
 
 	template<typename Key, typename Value, typename Alloc>
 	inline void unordered_map<Key, Value, Alloc>::clear() {
+		if (m_buckets.first == m_buckets.last)
+			return;
+
 		pointer it = *m_buckets.first;
 		while (it) {
 			const pointer next = it->next;
@@ -188,6 +202,10 @@ namespace tinystl {
 	template<typename Key, typename Value, typename Alloc>
 	inline typename unordered_map<Key, Value, Alloc>::iterator unordered_map<Key, Value, Alloc>::find(const Key& key) {
 		iterator result;
+		result.node = 0;
+		if (m_size == 0)
+			return result;
+
 		result.node = unordered_hash_find(key, m_buckets.first, (size_t)(m_buckets.last - m_buckets.first));
 		return result;
 	}
@@ -195,10 +213,20 @@ namespace tinystl {
 	template<typename Key, typename Value, typename Alloc>
 	inline typename unordered_map<Key, Value, Alloc>::const_iterator unordered_map<Key, Value, Alloc>::find(const Key& key) const {
 		iterator result;
+		result.node = 0;
+		if (m_size == 0)
+			return result;
+
 		result.node = unordered_hash_find(key, m_buckets.first, (size_t)(m_buckets.last - m_buckets.first));
 		return result;
 	}
 
+	template<typename Key, typename Value, typename Alloc>
+	inline void unordered_map<Key, Value, Alloc>::init_buckets() {
+		if (m_buckets.first == m_buckets.last)
+			buffer_resize<pointer, Alloc>(m_buckets, 9, 0);
+	}
+
 	template<typename Key, typename Value, typename Alloc>
 	inline void unordered_map<Key, Value, Alloc>::rehash(size_t nbuckets) {
 		if (m_size + 1 > 4 * nbuckets) {
@@ -230,6 +258,7 @@ namespace tinystl {
 		unordered_hash_node<Key, Value>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, Value>))) unordered_hash_node<Key, Value>(p.first, p.second);
 		newnode->next = newnode->prev = 0;
 
+		init_buckets();
 		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
 		unordered_hash_node_insert(newnode, hash(p.first), m_buckets.first, nbuckets - 1);
 
@@ -254,6 +283,7 @@ namespace tinystl {
 		unordered_hash_node<Key, Value>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, Value>))) unordered_hash_node<Key, Value>(static_cast<Key&&>(p.first), static_cast<Value&&>(p.second));
 		newnode->next = newnode->prev = 0;
 
+		init_buckets();
 		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
 		unordered_hash_node_insert(newnode, keyhash, m_buckets.first, nbuckets - 1);
 
@@ -286,6 +316,89 @@ namespace tinystl {
 			erase(where);
 	}
 
+	template<typename Key, typename Value, typename Alloc>
+	template<typename Predicate>
+	inline size_t unordered_map<Key, Value, Alloc>::erase_if(Predicate pred) {
+		if (m_size == 0)
+			return 0;
+
+		const size_t count = unordered_hash_node_erase_if<Alloc>(m_buckets.first, (size_t)(m_buckets.last - m_buckets.first) - 1, pred);
+		m_size -= count;
+		return count;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename unordered_map<Key, Value, Alloc>::node_type unordered_map<Key, Value, Alloc>::extract(const_iterator where) {
+		const pointer node = const_cast<pointer>(where.node);
+		unordered_hash_node_erase(node, hash(node->first), m_buckets.first, (size_t)(m_buckets.last - m_buckets.first) - 1);
+		node->next = node->prev = 0;
+		--m_size;
+
+		return node_type(node);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline typename unordered_map<Key, Value, Alloc>::node_type unordered_map<Key, Value, Alloc>::extract(const Key& key) {
+		const_iterator where = find(key);
+		if (where.node == 0)
+			return node_type();
+
+		return extract(where);
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline pair<typename unordered_map<Key, Value, Alloc>::iterator, bool> unordered_map<Key, Value, Alloc>::insert(node_type&& node) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		result.first.node = 0;
+		if (node.empty())
+			return result;
+
+		result.first = find(node.key());
+		if (result.first.node != 0)
+			return result;
+
+		init_buckets();
+		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
+		unordered_hash_node_insert(node.node, hash(node.key()), m_buckets.first, nbuckets - 1);
+
+		++m_size;
+		rehash(nbuckets);
+
+		result.first.node = node.node;
+		result.second = true;
+		node.node = 0;
+		return result;
+	}
+
+	template<typename Key, typename Value, typename Alloc>
+	inline void unordered_map<Key, Value, Alloc>::merge(unordered_map& other) {
+		if (&other == this || other.m_size == 0)
+			return;
+
+		init_buckets();
+		pointer it = *other.m_buckets.first;
+		while (it) {
+			const pointer next = it->next;
+
+			if (find(it->first).node == 0) {
+				const size_t keyhash = hash(it->first);
+				unordered_hash_node_erase(it, keyhash, other.m_buckets.first, (size_t)(other.m_buckets.last - other.m_buckets.first) - 1);
+				--other.m_size;
+
+				it->next = it->prev = 0;
+				const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
+				unordered_hash_node_insert(it, keyhash, m_buckets.first, nbuckets - 1);
+
+				++m_size;
+				rehash(nbuckets);
+			}
+
+			it = next;
+		}
+	}
+
 	template<typename Key, typename Value, typename Alloc>
 	inline Value& unordered_map<Key, Value, Alloc>::operator[](const Key& key) {
 		return insert(pair<Key, Value>(key, Value())).first->second;
@@ -297,5 +410,10 @@ namespace tinystl {
 		other.m_size = m_size, m_size = tsize;
 		buffer_swap(m_buckets, other.m_buckets);
 	}
+
+	template<typename Key, typename Value, typename Alloc, typename Predicate>
+	static inline size_t erase_if(unordered_map<Key, Value, Alloc>& m, Predicate pred) {
+		return m.erase_if(pred);
+	}
 }
 #endif
@@ -47,6 +47,7 @@ namespace tinystl {
 
 		typedef unordered_hash_iterator<const unordered_hash_node<Key, void> > const_iterator;
 		typedef const_iterator iterator;
+		typedef unordered_hash_node_handle<Key, void, Alloc> node_type;
 
 		iterator begin() const;
 		iterator end() const;
@@ -60,12 +61,20 @@ namespace tinystl {
 		pair<iterator, bool> emplace(Key&& key);
 		void erase(iterator where);
 		size_t erase(const Key& key);
+		template<typename Predicate>
+		size_t erase_if(Predicate pred);
+
+		node_type extract(iterator where);
+		node_type extract(const Key& key);
+		pair<iterator, bool> insert(node_type&& node);
+		void merge(unordered_set& other);
 
 		void swap(unordered_set& other);
 
 	private:
 
 		void rehash(size_t nbuckets);
+		void init_buckets();
 
 		typedef unordered_hash_node<Key, void>* pointer;
 
@@ -77,13 +86,15 @@ namespace tinystl {
 	inline unordered_set<Key, Alloc>::unordered_set()
 		: m_size(0)
 	{
-		buffer_resize<pointer, Alloc>(m_buckets, 9, 0);
 	}
 
 	template<typename Key, typename Alloc>
 	inline unordered_set<Key, Alloc>::unordered_set(const unordered_set& other)
 		: m_size(other.m_size)
 	{
+		if (other.m_buckets.first == other.m_buckets.last)
+			return;
+
 		const size_t nbuckets = (size_t)(other.m_buckets.last - other.m_buckets.first);
 		buffer_resize<pointer, Alloc>(m_buckets, nbuckets, 0);
 
@@ -124,7 +135,7 @@ namespace tinystl {
 	template<typename Key, typename Alloc>
 	inline typename unordered_set<Key, Alloc>::iterator unordered_set<Key, Alloc>::begin() const {
 		iterator cit;
-		cit.node = *m_buckets.first;
+		cit.node = (m_buckets.first != m_buckets.last) ? *m_buckets.first : 0;
 		return cit;
 	}
 
@@ -147,6 +158,9 @@ namespace tinystl {
 
 	template<typename Key, typename Alloc>
 	inline void unordered_set<Key, Alloc>::clear() {
+		if (m_buckets.first == m_buckets.last)
+			return;
+
 		pointer it = *m_buckets.first;
 		while (it) {
 			const pointer next = it->next;
@@ -164,10 +178,20 @@ namespace tinystl {
 	template<typename Key, typename Alloc>
 	inline typename unordered_set<Key, Alloc>::iterator unordered_set<Key, Alloc>::find(const Key& key) const {
 		iterator result;
+		result.node = 0;
+		if (m_size == 0)
+			return result;
+
 		result.node = unordered_hash_find(key, m_buckets.first, (size_t)(m_buckets.last - m_buckets.first));
 		return result;
 	}
 
+	template<typename Key, typename Alloc>
+	inline void unordered_set<Key, Alloc>::init_buckets() {
+		if (m_buckets.first == m_buckets.last)
+			buffer_resize<pointer, Alloc>(m_buckets, 9, 0);
+	}
+
 	template<typename Key, typename Alloc>
 	inline void unordered_set<Key, Alloc>::rehash(size_t nbuckets) {
 		if (m_size + 1 > 4 * nbuckets) {
@@ -199,6 +223,7 @@ namespace tinystl {
 		unordered_hash_node<Key, void>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, void>))) unordered_hash_node<Key, void>(key);
 		newnode->next = newnode->prev = 0;
 
+		init_buckets();
 		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
 		unordered_hash_node_insert(newnode, hash(key), m_buckets.first, nbuckets - 1);
 
@@ -223,6 +248,7 @@ namespace tinystl {
 		unordered_hash_node<Key, void>* newnode = new(placeholder(), Alloc::static_allocate(sizeof(unordered_hash_node<Key, void>))) unordered_hash_node<Key, void>(static_cast<Key&&>(key));
 		newnode->next = newnode->prev = 0;
 
+		init_buckets();
 		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
 		unordered_hash_node_insert(newnode, keyhash, m_buckets.first, nbuckets - 1);
 
@@ -253,11 +279,100 @@ namespace tinystl {
 		return 1;
 	}
 
+	template<typename Key, typename Alloc>
+	template<typename Predicate>
+	inline size_t unordered_set<Key, Alloc>::erase_if(Predicate pred) {
+		if (m_size == 0)
+			return 0;
+
+		const size_t count = unordered_hash_node_erase_if<Alloc>(m_buckets.first, (size_t)(m_buckets.last - m_buckets.first) - 1,
+			[&pred](const unordered_hash_node<Key, void>& node) { return pred(node.first); });
+		m_size -= count;
+		return count;
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename unordered_set<Key, Alloc>::node_type unordered_set<Key, Alloc>::extract(iterator where) {
+		const pointer node = where.node;
+		unordered_hash_node_erase(node, hash(node->first), m_buckets.first, (size_t)(m_buckets.last - m_buckets.first) - 1);
+		node->next = node->prev = 0;
+		--m_size;
+
+		return node_type(node);
+	}
+
+	template<typename Key, typename Alloc>
+	inline typename unordered_set<Key, Alloc>::node_type unordered_set<Key, Alloc>::extract(const Key& key) {
+		const iterator where = find(key);
+		if (where.node == 0)
+			return node_type();
+
+		return extract(where);
+	}
+
+	template<typename Key, typename Alloc>
+	inline pair<typename unordered_set<Key, Alloc>::iterator, bool> unordered_set<Key, Alloc>::insert(node_type&& node) {
+		pair<iterator, bool> result;
+		result.second = false;
+
+		result.first.node = 0;
+		if (node.empty())
+			return result;
+
+		result.first = find(node.value());
+		if (result.first.node != 0)
+			return result;
+
+		init_buckets();
+		const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
+		unordered_hash_node_insert(node.node, hash(node.value()), m_buckets.first, nbuckets - 1);
+
+		++m_size;
+		rehash(nbuckets);
+
+		result.first.node = node.node;
+		result.second = true;
+		node.node = 0;
+		return result;
+	}
+
+	template<typename Key, typename Alloc>
+	inline void unordered_set<Key, Alloc>::merge(unordered_set& other) {
+		if (&other == this || other.m_size == 0)
+			return;
+
+		init_buckets();
+		pointer it = *other.m_buckets.first;
+		while (it) {
+			const pointer next = it->next;
+
+			if (find(it->first).node == 0) {
+				const size_t keyhash = hash(it->first);
+				unordered_hash_node_erase(it, keyhash, other.m_buckets.first, (size_t)(other.m_buckets.last - other.m_buckets.first) - 1);
+				--other.m_size;
+
+				it->next = it->prev = 0;
+				const size_t nbuckets = (size_t)(m_buckets.last - m_buckets.first);
+				unordered_hash_node_insert(it, keyhash, m_buckets.first, nbuckets - 1);
+
+				++m_size;
+				rehash(nbuckets);
+			}
+
+			it = next;
+		}
+	}
+
 	template <typename Key, typename Alloc>
 	void unordered_set<Key, Alloc>::swap(unordered_set& other) {
 		size_t tsize = other.m_size;
 		other.m_size = m_size, m_size = tsize;
 		buffer_swap(m_buckets, other.m_buckets);
 	}
+
+	template<typename Key, typename Alloc, typename Predicate>
+	static inline size_t erase_if(unordered_set<Key, Alloc>& s, Predicate pred) {
+		return s.erase_if(pred);
+	}
 }
 #endif
@@ -107,6 +107,11 @@ namespace tinystl {
 		iterator erase_unordered(iterator where);
 		iterator erase_unordered(iterator first, iterator last);
 
+		template<typename Predicate>
+		size_t erase_if(Predicate pred);
+		template<typename Predicate>
+		size_t erase_if_unordered(Predicate pred);
+
 	protected:
 		buffer<T, Alloc> m_buffer;
 	};
@@ -341,11 +346,33 @@ namespace tinystl {
 		return buffer_erase_unordered(m_buffer, first, last);
 	}
 
+	template<typename T, typename Alloc>
+	template<typename Predicate>
+	inline size_t vector<T, Alloc>::erase_if(Predicate pred) {
+		return buffer_erase_if(m_buffer, pred);
+	}
+
+	template<typename T, typename Alloc>
+	template<typename Predicate>
+	inline size_t vector<T, Alloc>::erase_if_unordered(Predicate pred) {
+		return buffer_erase_if_unordered(m_buffer, pred);
+	}
+
 	template<typename T, typename Alloc>
 	template<typename... Params>
 	void vector<T, Alloc>::emplace(typename vector::iterator where, Params&&... params) {
 		buffer_emplace(m_buffer, where, 1, static_cast<Params&&>(params)...);
 	}
+
+	template<typename T, typename Alloc, typename Predicate>
+	static inline size_t erase_if(vector<T, Alloc>& v, Predicate pred) {
+		return v.erase_if(pred);
+	}
+
+	template<typename T, typename Alloc, typename Predicate>
+	static inline size_t erase_if_unordered(vector<T, Alloc>& v, Predicate pred) {
+		return v.erase_if_unordered(pred);
+	}
 }
 
 #endif // TINYSTL_VECTOR_H
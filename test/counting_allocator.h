@@ -0,0 +1,61 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TINYSTL_TEST_COUNTING_ALLOCATOR_H
+#define TINYSTL_TEST_COUNTING_ALLOCATOR_H
+
+#include <stddef.h>
+#include <new>
+
+// the counters are static members of a template so that every test file
+// can include this header and still share one definition
+template<typename T>
+struct counting_allocator_counters {
+	static size_t allocations;
+	static size_t deallocations;
+};
+
+template<typename T>
+size_t counting_allocator_counters<T>::allocations = 0;
+
+template<typename T>
+size_t counting_allocator_counters<T>::deallocations = 0;
+
+// Allocator that counts calls. The counters are shared by every test, so
+// tests compare them against values read at the start.
+struct counting_allocator : counting_allocator_counters<void> {
+	static void* static_allocate(size_t bytes) {
+		++allocations;
+		return ::operator new(bytes);
+	}
+
+	static void static_deallocate(void* ptr, size_t /*bytes*/) {
+		++deallocations;
+		::operator delete(ptr);
+	}
+};
+
+#endif
@@ -0,0 +1,118 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/dense_map.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <utility>
+
+TEST(dense_map_insert_find) {
+	typedef tinystl::dense_map<int, int> dense_map;
+	using tinystl::make_pair;
+
+	dense_map m;
+	CHECK( m.empty() );
+	CHECK( m.find(1) == 0 );
+	CHECK( m.erase(1) == 0 );
+
+	for (int ii = 0; ii != 100; ++ii)
+		CHECK( m.insert(make_pair(ii, ii * 3)).second );
+	CHECK( m.size() == 100 );
+
+	for (int ii = 0; ii != 100; ++ii) {
+		const int* value = m.find(ii);
+		CHECK( value && *value == ii * 3 );
+	}
+	CHECK( m.find(100) == 0 );
+
+	tinystl::pair<int*, bool> p = m.insert(make_pair(5, 0));
+	CHECK( !p.second );
+	CHECK( *p.first == 15 );
+
+	m[200] = 7;
+	CHECK( m.size() == 101 );
+	CHECK( m[200] == 7 );
+
+	int sum = 0;
+	for (const int* it = m.values(), *end = it + m.size(); it != end; ++it)
+		sum += *it;
+	CHECK( sum == 3 * (99 * 100 / 2) + 7 );
+}
+
+TEST(dense_map_erase) {
+	typedef tinystl::dense_map<int, int> dense_map;
+	using tinystl::make_pair;
+
+	dense_map m;
+	for (int ii = 0; ii != 64; ++ii)
+		m.insert(make_pair(ii, ii));
+
+	for (int ii = 0; ii < 64; ii += 3)
+		CHECK( m.erase(ii) == 1 );
+	CHECK( m.erase(0) == 0 );
+
+	for (int ii = 0; ii != 64; ++ii) {
+		const int* value = m.find(ii);
+		if (ii % 3 == 0) {
+			CHECK( value == 0 );
+		} else {
+			CHECK( value && *value == ii );
+		}
+	}
+
+	for (size_t ii = 0; ii != m.size(); ++ii)
+		CHECK( m.keys()[ii] == m.values()[ii] );
+
+	m.clear();
+	CHECK( m.empty() );
+	CHECK( m.find(1) == 0 );
+	m[1] = 2;
+	CHECK( *m.find(1) == 2 );
+}
+
+TEST(dense_map_string) {
+	using tinystl::string;
+	typedef tinystl::dense_map<string, string> dense_map;
+
+	dense_map m;
+	m.reserve(32);
+	m.insert(tinystl::make_pair(string("hello"), string("world")));
+	m["key"] = "a value that does not fit in the small buffer";
+
+	dense_map copy = m;
+	CHECK( copy.size() == 2 );
+	CHECK( *copy.find("hello") == "world" );
+
+	CHECK( m.erase("hello") == 1 );
+	CHECK( m.size() == 1 );
+	CHECK( m.keys()[0] == "key" );
+	CHECK( *m.find("key") == "a value that does not fit in the small buffer" );
+
+	dense_map moved = std::move(copy);
+	CHECK( moved.size() == 2 );
+	CHECK( copy.empty() );
+	CHECK( copy.find("hello") == 0 );
+}
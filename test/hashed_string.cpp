@@ -0,0 +1,84 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/hashed_string.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/unordered_set.h>
+#include <UnitTest++.h>
+
+#include <stdio.h>
+#include <string.h>
+
+TEST(hashed_string_hash) {
+	typedef tinystl::hashed_string hashed_string;
+
+	const char* text = "tenant/4711/region/eu-west/bucket/logs/2017/03/14/part-00042.gz";
+	const hashed_string key(text);
+	CHECK( hash(key) == tinystl::hash_string(text, strlen(text)) );
+	CHECK( hash(key) == hash(tinystl::string(text)) );
+	CHECK( key.size() == strlen(text) );
+	CHECK( 0 == strcmp(key.c_str(), text) );
+	CHECK( key.view() == text );
+
+	hashed_string other(key);
+	CHECK( other == key );
+	CHECK( hash(other) == hash(key) );
+
+	other = tinystl::string_view("tenant/4711");
+	CHECK( other != key );
+	CHECK( hash(other) == tinystl::hash_string("tenant/4711", 11) );
+
+	other.clear();
+	CHECK( other.empty() );
+	CHECK( other == hashed_string() );
+	CHECK( hash(other) == hash(hashed_string("")) );
+
+	tinystl::string s("moved");
+	const hashed_string moved(static_cast<tinystl::string&&>(s));
+	CHECK( moved == "moved" );
+	CHECK( hash(moved) == tinystl::hash_string("moved", 5) );
+}
+
+TEST(hashed_string_keys) {
+	typedef tinystl::basic_hashed_string<TINYSTL_ALLOCATOR, 32> key_type;
+
+	tinystl::unordered_map<key_type, int> map;
+	tinystl::unordered_set<key_type> set;
+	char name[64];
+	for(int ii = 0; ii < 200; ++ii) {
+		const int len = sprintf(name, "composite/key/with/a/long/shared/prefix/%d", ii);
+		const key_type key(name, (size_t)len);
+		map[key] = ii;
+		set.insert(key);
+	}
+
+	CHECK( map.size() == 200 );
+	CHECK( set.size() == 200 );
+	CHECK( map.find("composite/key/with/a/long/shared/prefix/42")->second == 42 );
+	CHECK( set.find("composite/key/with/a/long/shared/prefix/199") != set.end() );
+	CHECK( map.find("composite/key/with/a/long/shared/prefix/200") == map.end() );
+}
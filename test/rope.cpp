@@ -0,0 +1,129 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/rope.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+
+#include <stdlib.h>
+
+TEST(rope_edit) {
+	tinystl::rope r(tinystl::string_view("hello world"));
+	CHECK( r.size() == 11 );
+	CHECK( r == "hello world" );
+
+	r.insert(5, ",");
+	r.insert(r.size(), "!");
+	r.insert(0, ">> ");
+	CHECK( r == ">> hello, world!" );
+	CHECK( r[3] == 'h' );
+
+	r.erase(0, 3);
+	r.erase(5, 1);
+	CHECK( r == "hello world!" );
+
+	r.erase(5);
+	CHECK( r == "hello" );
+
+	r.erase(100, 2);
+	r.erase(5, 100);
+	CHECK( r == "hello" );
+
+	r.erase(0, 100);
+	CHECK( r.empty() );
+	CHECK( r == "" );
+}
+
+TEST(rope_random_edits) {
+	tinystl::rope r;
+	tinystl::string model;
+	char text[64];
+
+	srand(1);
+	for(int ii = 0; ii < 5000; ++ii) {
+		const size_t pos = model.empty() ? 0 : (size_t)rand() % (model.size() + 1);
+		if(rand() % 3 == 0 && !model.empty()) {
+			size_t len = (size_t)rand() % 16;
+			if(len > model.size() - pos)
+				len = model.size() - pos;
+			r.erase(pos, len);
+			model.erase(pos, len);
+		} else {
+			const size_t len = 1 + (size_t)rand() % (sizeof(text) - 1);
+			for(size_t jj = 0; jj < len; ++jj)
+				text[jj] = (char)('a' + rand() % 26);
+			r.insert(pos, tinystl::string_view(text, len));
+			model.insert(pos, tinystl::string_view(text, len));
+		}
+	}
+
+	CHECK( r.size() == model.size() );
+	CHECK( r == model.view() );
+
+	// typing at one spot extends a single piece
+	tinystl::rope typed;
+	for(int ii = 0; ii < 1000; ++ii)
+		typed.append("x");
+	size_t nchunks = 0;
+	for(tinystl::string_view chunk : typed.chunks())
+		nchunks += chunk.size() ? 1 : 0;
+	CHECK( typed.size() == 1000 );
+	CHECK( nchunks == 1 );
+}
+
+TEST(rope_substr_chunks) {
+	tinystl::rope r(tinystl::string_view("0123456789"));
+	r.insert(5, "abcde");
+	r.insert(0, "XY");
+
+	tinystl::rope copy(r);
+	const tinystl::rope sub = r.substr(4, 9);
+	CHECK( sub == "234abcde5" );
+	CHECK( r.substr(0) == "XY01234abcde56789" );
+	CHECK( r.substr(17).empty() );
+	CHECK( r.substr(30).empty() );
+	CHECK( r.substr(30, 5).empty() );
+	CHECK( r.substr(15, 100) == "89" );
+
+	// substrings and copies share the characters of their source
+	CHECK( sub.chunk(0).data() == r.chunk(4).data() );
+	CHECK( copy.chunk(7).data() == r.chunk(7).data() );
+
+	r.erase(0, 7);
+	r.append("!");
+	CHECK( r == "abcde56789!" );
+	CHECK( copy == "XY01234abcde56789" );
+	CHECK( sub == "234abcde5" );
+
+	tinystl::string flat;
+	for(tinystl::rope::chunk_iterator it = copy.chunks().begin(), end = copy.chunks().end(); it != end; ++it)
+		flat.append(it->begin(), it->end());
+	CHECK( flat == "XY01234abcde56789" );
+
+	char buffer[8];
+	CHECK( copy.copy(buffer, 8, 13) == 4 );
+	CHECK( tinystl::string_view(buffer, 4) == "6789" );
+}
@@ -0,0 +1,108 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/shared_string.h>
+#include <TINYSTL/string.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+#include "counting_allocator.h"
+
+TEST(shared_string_inline) {
+	typedef tinystl::basic_shared_string<counting_allocator> shared_string;
+
+	const size_t allocations = counting_allocator::allocations;
+	{
+		shared_string empty;
+		CHECK( empty.empty() );
+		CHECK( empty.c_str()[0] == 0 );
+
+		const shared_string s("short");
+		shared_string copy = s;
+		CHECK( copy == "short" );
+		CHECK( copy.size() == 5 );
+		CHECK( copy.c_str()[5] == 0 );
+		CHECK( !copy.shares(s) );
+
+		// exactly fills the inline buffer
+		const char* full = "0123456789abcdefghijklmnopqrstuvwxyz";
+		const shared_string longest(full, sizeof(void*) * 3 - 1);
+		CHECK( longest.size() == sizeof(void*) * 3 - 1 );
+		CHECK( longest.c_str()[longest.size()] == 0 );
+		CHECK( longest.view() == tinystl::string_view(full, longest.size()) );
+	}
+	CHECK( counting_allocator::allocations == allocations );
+}
+
+TEST(shared_string_copies_share) {
+	typedef tinystl::basic_shared_string<counting_allocator> shared_string;
+
+	const char* text = "a configuration value that is too long to be stored inline";
+	const size_t allocations = counting_allocator::allocations;
+	const size_t deallocations = counting_allocator::deallocations;
+	{
+		const shared_string original(text);
+		CHECK( counting_allocator::allocations == allocations + 1 );
+
+		tinystl::vector<shared_string> consumers;
+		for(int ii = 0; ii < 100; ++ii)
+			consumers.push_back(original);
+
+		const size_t before = counting_allocator::allocations;
+		shared_string copy(original);
+		shared_string assigned;
+		assigned = copy;
+		shared_string moved(static_cast<shared_string&&>(copy));
+		CHECK( counting_allocator::allocations == before );
+
+		CHECK( copy.empty() );
+		CHECK( moved.shares(original) );
+		CHECK( assigned.shares(original) );
+		CHECK( consumers[99].data() == original.data() );
+		CHECK( assigned == text );
+		CHECK( assigned == original );
+		CHECK( tinystl::hash(assigned) == tinystl::hash(tinystl::string(text)) );
+
+		// a distinct block with the same contents still compares equal
+		const tinystl::string_view view(text);
+		const shared_string other(view);
+		CHECK( !other.shares(original) );
+		CHECK( other == original );
+		CHECK( !(other < original) && !(original < other) );
+	}
+	CHECK( counting_allocator::deallocations - deallocations == counting_allocator::allocations - allocations );
+}
+
+TEST(shared_string_keys) {
+	tinystl::unordered_map<tinystl::shared_string, int> map;
+	map.insert(tinystl::make_pair(tinystl::shared_string("alpha"), 1));
+	map.insert(tinystl::make_pair(tinystl::shared_string("a much longer key that lives on the heap"), 2));
+
+	CHECK( map.find("alpha")->second == 1 );
+	CHECK( map.find("a much longer key that lives on the heap")->second == 2 );
+	CHECK( map.find("beta") == map.end() );
+}
@@ -0,0 +1,148 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/small_unordered_map.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <utility>
+
+#include "counting_allocator.h"
+
+TEST(uomap_default_no_allocation) {
+	typedef tinystl::unordered_map<int, int, counting_allocator> unordered_map;
+
+	const size_t allocations = counting_allocator::allocations;
+	{
+		unordered_map m;
+		CHECK( m.empty() );
+		CHECK( m.begin() == m.end() );
+		CHECK( m.find(3) == m.end() );
+		m.erase(3);
+		m.clear();
+
+		unordered_map copy = m;
+		CHECK( copy.empty() );
+	}
+	CHECK( counting_allocator::allocations == allocations );
+
+	unordered_map m;
+	m[3] = 4;
+	CHECK( m.size() == 1 );
+	CHECK( m[3] == 4 );
+}
+
+TEST(small_uomap_inline) {
+	typedef tinystl::small_unordered_map<int, int, 4, counting_allocator> small_map;
+	using tinystl::make_pair;
+
+	const size_t allocations = counting_allocator::allocations;
+	small_map m;
+	for (int ii = 0; ii != 4; ++ii)
+		CHECK( m.insert(make_pair(ii, ii * 10)).second );
+	CHECK( !m.insert(make_pair(2, 0)).second );
+	CHECK( m.size() == 4 );
+	CHECK( counting_allocator::allocations == allocations );
+
+	for (int ii = 0; ii != 4; ++ii)
+		CHECK( m.find(ii)->second == ii * 10 );
+	CHECK( m.find(4) == m.end() );
+
+	int sum = 0;
+	for (small_map::iterator it = m.begin(), end = m.end(); it != end; ++it)
+		sum += it->second;
+	CHECK( sum == 60 );
+
+	m.erase(1);
+	CHECK( m.size() == 3 );
+	CHECK( m.find(1) == m.end() );
+	CHECK( m[3] == 30 );
+
+	sum = 0;
+	for (small_map::const_iterator it = m.begin(), end = m.end(); it != end; ++it)
+		sum += it->second;
+	CHECK( sum == 50 );
+	CHECK( counting_allocator::allocations == allocations );
+}
+
+TEST(small_uomap_spill) {
+	typedef tinystl::small_unordered_map<int, int, 4> small_map;
+	using tinystl::make_pair;
+
+	small_map m;
+	for (int ii = 0; ii != 20; ++ii)
+		m[ii] = ii;
+	CHECK( m.size() == 20 );
+	for (int ii = 0; ii != 20; ++ii)
+		CHECK( m.find(ii) != m.end() && m.find(ii)->second == ii );
+
+	size_t count = 0;
+	for (small_map::iterator it = m.begin(), end = m.end(); it != end; ++it)
+		++count;
+	CHECK( count == 20 );
+
+	for (int ii = 0; ii != 20; ++ii)
+		m.erase(ii);
+	CHECK( m.empty() );
+
+	m[7] = 1;
+	CHECK( m.size() == 1 );
+	CHECK( m[7] == 1 );
+}
+
+TEST(small_uomap_copy_move_swap) {
+	using tinystl::string;
+	typedef tinystl::small_unordered_map<string, string, 2> small_map;
+
+	small_map a;
+	a["hello"] = "world";
+	a["key"] = "a value that does not fit in the small buffer";
+
+	small_map b = a;
+	CHECK( b.size() == 2 );
+	CHECK( b["hello"] == "world" );
+
+	small_map c = std::move(a);
+	CHECK( a.empty() );
+	CHECK( c.size() == 2 );
+	CHECK( c["key"] == "a value that does not fit in the small buffer" );
+
+	small_map d;
+	for (int ii = 0; ii != 5; ++ii) {
+		char name[] = { 'k', char('0' + ii), 0 };
+		d[name] = name;
+	}
+
+	c.swap(d);
+	CHECK( c.size() == 5 );
+	CHECK( d.size() == 2 );
+	CHECK( c["k3"] == "k3" );
+	CHECK( d["hello"] == "world" );
+
+	d = c;
+	CHECK( d.size() == 5 );
+	CHECK( d["k4"] == "k4" );
+}
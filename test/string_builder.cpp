@@ -0,0 +1,109 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string_builder.h>
+#include <UnitTest++.h>
+
+#include "counting_allocator.h"
+
+TEST(string_concat) {
+	using tinystl::string;
+
+	const string status("200 OK");
+	const tinystl::string_view version("HTTP/1.1");
+
+	const string line = tinystl::concat(version, " ", status, "\r\n");
+	CHECK( line == "HTTP/1.1 200 OK\r\n" );
+	CHECK( tinystl::concat("a") == "a" );
+	CHECK( tinystl::concat().empty() );
+}
+
+TEST(string_concat_single_allocation) {
+	typedef tinystl::basic_string<counting_allocator> string;
+
+	const char* piece = "a fragment of a response body that is long enough, ";
+	string body;
+
+	const size_t allocations = counting_allocator::allocations;
+	tinystl::concat_append(body, piece, piece, piece, piece, piece, piece, piece, piece);
+	CHECK( counting_allocator::allocations == allocations + 1 );
+	CHECK( body.size() == 8 * tinystl::string_view(piece).size() );
+	CHECK( body.capacity() == body.size() );
+	CHECK( body.starts_with(piece) && body.ends_with(piece) );
+}
+
+TEST(string_concat_self) {
+	using tinystl::string;
+
+	// inline destination that moves to the heap
+	{
+		string s("abc");
+		tinystl::concat_append(s, s, "-a piece long enough to leave the buffer");
+		CHECK( s == "abcabc-a piece long enough to leave the buffer" );
+	}
+	// heap destination that reallocates
+	{
+		string s("a string that already lives on the heap");
+		tinystl::concat_append(s, "|", s, "|", s.substr_view(2, 6));
+		CHECK( s == "a string that already lives on the heap|a string that already lives on the heap|string" );
+	}
+	// builder pieces viewing the destination
+	{
+		string t("a string that already lives on the heap");
+		tinystl::string_builder b;
+		b << t << "!";
+		b.append_to(t);
+		CHECK( t == "a string that already lives on the heapa string that already lives on the heap!" );
+	}
+}
+
+TEST(string_builder) {
+	typedef tinystl::basic_string_builder<counting_allocator> string_builder;
+
+	const tinystl::string header("Content-Length: ");
+	const char* fragments[] = { "<html>", "<head><title>title</title></head>", "<body>", "...", "</body>", "</html>" };
+
+	string_builder builder;
+	builder.reserve(16);
+	builder << header << "42" << "\r\n\r\n";
+	for(const char* fragment : fragments)
+		builder.append(fragment);
+	CHECK( builder.size() == header.size() + 6 + 62 );
+
+	const size_t allocations = counting_allocator::allocations;
+	const tinystl::basic_string<counting_allocator> s = builder.str();
+	CHECK( counting_allocator::allocations == allocations + 1 );
+	CHECK( s.size() == builder.size() );
+	CHECK( s.starts_with("Content-Length: 42\r\n\r\n<html>") );
+	CHECK( s.ends_with("...</body></html>") );
+
+	tinystl::string prefix("> ");
+	builder.clear();
+	builder << "x" << "y";
+	builder.append_to(prefix);
+	CHECK( prefix == "> xy" );
+	CHECK( !builder.empty() );
+}
@@ -0,0 +1,117 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <string.h>
+#include <utility>
+
+TEST(string_inline_capacity) {
+	typedef tinystl::basic_string<TINYSTL_ALLOCATOR, 63> path_string;
+
+	CHECK( sizeof(path_string) == 64 );
+	CHECK( sizeof(tinystl::basic_string<TINYSTL_ALLOCATOR, 1>) == sizeof(tinystl::string) );
+
+	const char* path = "assets/textures/environment/skybox/daylight_cloudy_01.dds";
+	path_string s(path);
+	CHECK( s.capacity() == 63 );
+	CHECK( 0 == strcmp(s.c_str(), path) );
+	CHECK( (const void*)s.c_str() >= (const void*)&s && (const void*)s.c_str() < (const void*)(&s + 1) );
+
+	s.append(path, path + 10);
+	CHECK( s.size() == strlen(path) + 10 );
+	CHECK( s.capacity() > 63 );
+	CHECK( 0 == strncmp(s.c_str(), path, strlen(path)) );
+
+	path_string moved = std::move(s);
+	CHECK( moved.size() == strlen(path) + 10 );
+	CHECK( s.empty() );
+
+	moved.resize(4);
+	moved.shrink_to_fit();
+	CHECK( moved.capacity() == 63 );
+	CHECK( 0 == strcmp(moved.c_str(), "asse") );
+}
+
+TEST(string_fixed) {
+	typedef tinystl::fixed_string<15> fixed_string;
+
+	CHECK( sizeof(fixed_string) == sizeof(tinystl::string) );
+
+	fixed_string s("0123456789");
+	CHECK( s.capacity() == 22 );
+	CHECK( !s.truncated() );
+
+	s.append(s);
+	CHECK( s.size() == 20 );
+	CHECK( !s.truncated() );
+
+	s.append(s);
+	CHECK( s.size() == 22 );
+	CHECK( 0 == strcmp(s.c_str(), "0123456789012345678901") );
+	CHECK( s.truncated() );
+
+	s.clear();
+	CHECK( !s.truncated() );
+	s.assign("0123456789012345678901", 22);
+	CHECK( !s.truncated() );
+
+	s.push_back('x');
+	CHECK( s.size() == 22 );
+	CHECK( s.truncated() );
+
+	s.assign("0123456789012345678901", 22);
+	s.insert((size_t)0, 'x');
+	CHECK( s.size() == 22 );
+	CHECK( 0 == strcmp(s.c_str(), "x012345678901234567890") );
+	CHECK( s.truncated() );
+
+	s.erase(1, 10);
+	CHECK( 0 == strcmp(s.c_str(), "x01234567890") );
+
+	s.assign("x01234567890", 12);
+	s.resize(100, 'y');
+	CHECK( s.size() == 22 );
+	CHECK( s.back() == 'y' );
+	CHECK( s.c_str()[22] == 0 );
+	CHECK( s.truncated() );
+
+	s.reserve(100);
+	CHECK( s.capacity() == 22 );
+
+	fixed_string t(40, 'z');
+	CHECK( t.size() == 22 );
+	CHECK( t.truncated() );
+	t.swap(s);
+	CHECK( s.back() == 'z' );
+	CHECK( t.back() == 'y' );
+
+	// a value that fits exactly is not truncated
+	tinystl::fixed_string<8> exact("01234567");
+	CHECK( exact.size() == 8 );
+	CHECK( !exact.truncated() );
+	CHECK( !tinystl::string(40, 'z').truncated() );
+}
@@ -0,0 +1,86 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_view.h>
+#include <UnitTest++.h>
+
+#include "counting_allocator.h"
+
+TEST(string_compare_literal_no_allocation) {
+	typedef tinystl::basic_string<counting_allocator> string;
+
+	const char* literal = "application/x-www-form-urlencoded";
+	const string header(literal);
+	const string other("text/plain");
+
+	const size_t allocations = counting_allocator::allocations;
+	CHECK( header == literal );
+	CHECK( literal == header );
+	CHECK( !(header != literal) );
+	CHECK( other != literal );
+	CHECK( literal != other );
+	CHECK( !(header == "application/x-www-form-urlencode") );
+
+	CHECK( header == tinystl::string_view(literal) );
+	CHECK( tinystl::string_view(literal) == header );
+	CHECK( header != tinystl::string_view(literal, 11) );
+	CHECK( tinystl::string_view(literal, 11) != header );
+
+	CHECK( header.compare(literal) == 0 );
+	CHECK( header.compare("b") < 0 );
+	CHECK( header.compare("application") > 0 );
+	CHECK( other.compare(tinystl::string_view(literal)) > 0 );
+	CHECK( counting_allocator::allocations == allocations );
+}
+
+TEST(string_starts_ends_contains) {
+	using tinystl::string;
+
+	const string s("GET /index.html HTTP/1.1");
+	CHECK( s.starts_with("GET ") );
+	CHECK( s.starts_with('G') );
+	CHECK( s.starts_with("") );
+	CHECK( !s.starts_with("POST") );
+	CHECK( !s.starts_with("GET /index.html HTTP/1.1 and more") );
+
+	CHECK( s.ends_with("HTTP/1.1") );
+	CHECK( s.ends_with('1') );
+	CHECK( s.ends_with("") );
+	CHECK( !s.ends_with("HTTP/1.0") );
+
+	CHECK( s.contains("/index") );
+	CHECK( s.contains(' ') );
+	CHECK( s.contains("") );
+	CHECK( !s.contains("/about") );
+	CHECK( !s.contains('?') );
+
+	const string empty;
+	CHECK( !empty.starts_with('a') );
+	CHECK( !empty.ends_with('a') );
+	CHECK( empty.starts_with("") );
+	CHECK( !empty.contains('a') );
+}
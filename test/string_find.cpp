@@ -0,0 +1,111 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_view.h>
+#include <UnitTest++.h>
+
+static size_t naive_find(const char* hay, size_t hay_size, const char* needle, size_t needle_size, size_t offset) {
+	for(size_t pos = offset; pos + needle_size <= hay_size; ++pos) {
+		size_t ii = 0;
+		while(ii < needle_size && hay[pos + ii] == needle[ii])
+			++ii;
+		if(ii == needle_size)
+			return pos;
+	}
+	return size_t(-1);
+}
+
+static size_t naive_rfind(const char* hay, size_t hay_size, const char* needle, size_t needle_size, size_t offset) {
+	if(needle_size > hay_size)
+		return size_t(-1);
+	for(size_t pos = (offset < hay_size - needle_size ? offset : hay_size - needle_size); ; --pos) {
+		size_t ii = 0;
+		while(ii < needle_size && hay[pos + ii] == needle[ii])
+			++ii;
+		if(ii == needle_size)
+			return pos;
+		if(pos == 0)
+			return size_t(-1);
+	}
+}
+
+TEST(string_find_substring) {
+	using tinystl::string;
+
+	const string hay("the quick brown fox jumps over the lazy dog");
+	CHECK( hay.find(string("the")) == 0 );
+	CHECK( hay.find(string("the"), 1) == 31 );
+	CHECK( hay.find(string("dog")) == 40 );
+	CHECK( hay.find(string("cat")) == string::npos );
+	CHECK( hay.find(string("")) == 0 );
+	CHECK( hay.find(string(""), 43) == 43 );
+	CHECK( hay.find(string(""), 44) == string::npos );
+
+	CHECK( hay.rfind(string("the")) == 31 );
+	CHECK( hay.rfind(string("the"), 30) == 0 );
+	CHECK( hay.rfind(string("t")) == 31 );
+	CHECK( hay.rfind(string("quick"), 0) == string::npos );
+	CHECK( hay.rfind(string("")) == 43 );
+	CHECK( string("a").rfind(string("a")) == 0 );
+}
+
+TEST(string_find_matches_naive) {
+	using tinystl::string;
+
+	// a small alphabet produces many partial matches
+	char text[300];
+	unsigned seed = 7;
+	for(size_t ii = 0; ii < sizeof(text); ++ii) {
+		seed = seed * 1103515245 + 12345;
+		text[ii] = "abc"[(seed >> 16) % 3];
+	}
+
+	const string hay(text, sizeof(text));
+	const tinystl::string_view hay_view(text, sizeof(text));
+	const size_t needle_sizes[] = { 1, 2, 3, 5, 8, 17, 31, 32, 40, 90 };
+	for(size_t needle_size : needle_sizes) {
+		for(size_t start = 0; start + needle_size <= sizeof(text); start += 37) {
+			const string needle(text + start, needle_size);
+			const tinystl::string_view needle_view(text + start, needle_size);
+			for(size_t offset = 0; offset < sizeof(text); offset += 29) {
+				const size_t expected = naive_find(text, sizeof(text), text + start, needle_size, offset);
+				CHECK( hay.find(needle, offset) == expected );
+				CHECK( hay_view.find(needle_view, offset) == expected );
+
+				const size_t rexpected = naive_rfind(text, sizeof(text), text + start, needle_size, offset);
+				CHECK( hay.rfind(needle, offset) == rexpected );
+				CHECK( hay_view.rfind(needle_view, offset) == rexpected );
+			}
+		}
+
+		// mismatch in the last byte only
+		string missing(text, needle_size);
+		missing.back() = 'z';
+		CHECK( hay.find(missing) == string::npos );
+		CHECK( hay.rfind(missing) == string::npos );
+	}
+}
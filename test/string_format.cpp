@@ -0,0 +1,136 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_format.h>
+#include <UnitTest++.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "counting_allocator.h"
+
+TEST(string_append_integers) {
+	using tinystl::string;
+
+	string s;
+	append_int(s, 0);
+	s.push_back(' ');
+	append_int(s, -7);
+	s.push_back(' ');
+	append_int(s, 1234567890123ll);
+	s.push_back(' ');
+	append_int(s, -9223372036854775807ll - 1);
+	s.push_back(' ');
+	append_uint(s, 18446744073709551615ull);
+	CHECK( s == "0 -7 1234567890123 -9223372036854775808 18446744073709551615" );
+
+	string h;
+	append_hex(h, 0);
+	h.push_back(' ');
+	append_hex(h, 0xdeadbeefull);
+	h.push_back(' ');
+	append_hex(h, 0xffffffffffffffffull);
+	CHECK( h == "0 deadbeef ffffffffffffffff" );
+
+	for(unsigned long long value = 1, digits = 1; digits <= 19; value *= 10, ++digits) {
+		string d;
+		append_uint(d, value - 1);
+		append_uint(d, value);
+		CHECK( d.size() == (digits == 1 ? 1 : digits - 1) + digits );
+	}
+}
+
+TEST(string_append_double) {
+	using tinystl::string;
+
+	const struct { double value; const char* text; } cases[] = {
+		{ 0.0, "0" },
+		{ -0.0, "-0" },
+		{ 1.0, "1" },
+		{ 0.1, "0.1" },
+		{ -2.5, "-2.5" },
+		{ 100.0, "100" },
+		{ 1e21, "1e+21" },
+		{ 1e20, "100000000000000000000" },
+		{ 123456.789, "123456.789" },
+		{ 0.000001, "0.000001" },
+		{ 0.0000001, "1e-7" },
+		{ 1.0 / 3.0, "0.3333333333333333" },
+		{ 5e-324, "5e-324" },
+		{ 1.7976931348623157e308, "1.7976931348623157e+308" },
+		{ 2.2250738585072014e-308, "2.2250738585072014e-308" },
+		{ 9007199254740993.0, "9007199254740992" },
+	};
+
+	for(const auto& c : cases) {
+		string s;
+		append_double(s, c.value);
+		CHECK( s == c.text );
+	}
+
+	string special;
+	append_double(special, 1.0 / 0.0);
+	special.push_back(' ');
+	append_double(special, -1.0 / 0.0);
+	CHECK( special == "inf -inf" );
+}
+
+TEST(string_append_double_round_trip) {
+	unsigned long long seed = 12345;
+	for(int ii = 0; ii < 20000; ++ii) {
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		const unsigned long long bits = seed & 0x7fefffffffffffffull;
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+
+		tinystl::string s;
+		append_double(s, value);
+		CHECK( strtod(s.c_str(), 0) == value );
+	}
+}
+
+TEST(string_append_number_fixed) {
+	tinystl::fixed_string<0> s("0123456789012345678");
+	CHECK( !s.truncated() );
+	append_uint(s, 123456789);
+	CHECK( s == "0123456789012345678123" );
+	CHECK( s.truncated() );
+}
+
+TEST(string_append_number_in_place) {
+	typedef tinystl::basic_string<counting_allocator> string;
+
+	string s;
+	s.reserve(100);
+	const size_t allocations = counting_allocator::allocations;
+	append_uint(s, 18446744073709551615ull);
+	append_int(s, -42);
+	append_hex(s, 0xbeefull);
+	append_double(s, 0.1);
+	CHECK( counting_allocator::allocations == allocations );
+	CHECK( s == "18446744073709551615-42beef0.1" );
+	CHECK( s.size() == 30 );
+}
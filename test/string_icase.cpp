@@ -0,0 +1,127 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_icase.h>
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/unordered_set.h>
+#include <UnitTest++.h>
+
+TEST(icase_equals) {
+	using tinystl::iequals;
+
+	CHECK( iequals("", "") );
+	CHECK( iequals("Content-Type", "content-type") );
+	CHECK( iequals("SELECT", "select") );
+	CHECK( !iequals("select", "selec") );
+	CHECK( !iequals("select", "selecd") );
+
+	// only ascii letters fold
+	CHECK( !iequals("@[`{", "`{@[") );
+	CHECK( !iequals("\xc0", "\xe0") );
+
+	// differences at every position of texts longer than a block
+	char lhs[80], rhs[80];
+	for(size_t ii = 0; ii < sizeof(lhs); ++ii) {
+		lhs[ii] = (char)('a' + ii % 26);
+		rhs[ii] = (char)('A' + ii % 26);
+	}
+	for(size_t len = 0; len <= sizeof(lhs); ++len) {
+		CHECK( iequals(tinystl::string_view(lhs, len), tinystl::string_view(rhs, len)) );
+		for(size_t pos = 0; pos < len; ++pos) {
+			rhs[pos] ^= 0x01;
+			CHECK( !iequals(tinystl::string_view(lhs, len), tinystl::string_view(rhs, len)) );
+			rhs[pos] ^= 0x01;
+		}
+	}
+
+	static_assert(iequals("Accept", "ACCEPT"), "iequals is usable in constant expressions");
+}
+
+TEST(icase_hash) {
+	const char* mixed = "X-Forwarded-For: Some-Long-Header-Value-Crossing-Blocks";
+	const char* lower = "x-forwarded-for: some-long-header-value-crossing-blocks";
+	const size_t len = tinystl::string_view(mixed).size();
+
+	CHECK( tinystl::hash_string_icase(mixed, len) == tinystl::hash_string(lower, len) );
+	CHECK( tinystl::hash_string_icase(mixed, len) == tinystl::hash_string_icase(lower, len) );
+	CHECK( tinystl::hash_string_icase(mixed, 5) != tinystl::hash_string_icase(mixed, 6) );
+}
+
+TEST(icase_keys) {
+	using tinystl::icase_string;
+	using tinystl::icase_string_view;
+
+	tinystl::unordered_map<icase_string_view, int> headers;
+	headers.insert(tinystl::make_pair(icase_string_view("Content-Length"), 42));
+	headers.insert(tinystl::make_pair(icase_string_view("Host"), 7));
+	CHECK( headers.find("content-length") != headers.end() );
+	CHECK( headers.find("CONTENT-LENGTH")->second == 42 );
+	CHECK( headers.find("hosts") == headers.end() );
+	CHECK( !headers.insert(tinystl::make_pair(icase_string_view("HOST"), 8)).second );
+
+	tinystl::unordered_set<icase_string> identifiers;
+	identifiers.insert("Users");
+	identifiers.insert(icase_string(tinystl::string_view("ORDERS")));
+	CHECK( identifiers.size() == 2 );
+	CHECK( identifiers.find("users") != identifiers.end() );
+	CHECK( identifiers.find(tinystl::string_view("orders")) != identifiers.end() );
+	CHECK( !identifiers.insert("uSeRs").second );
+
+	// the stored key keeps its original spelling
+	CHECK( *identifiers.find("USERS") == tinystl::string("Users") );
+}
+
+TEST(icase_string_compare) {
+	using tinystl::icase_string;
+	using tinystl::string_view;
+
+	const icase_string name("Content-Type");
+	CHECK( name == "content-type" );
+	CHECK( "CONTENT-TYPE" == name );
+	CHECK( name == string_view("content-TYPE") );
+	CHECK( string_view("Content-type") == name );
+	CHECK( name != "content-types" );
+	CHECK( "content-typ" != name );
+	CHECK( name != string_view("content_type") );
+	CHECK( string_view("") != name );
+	CHECK( name == tinystl::string("CONTENT-type") );
+	CHECK( tinystl::string("content-type") == name );
+	CHECK( name != tinystl::string("content") );
+	CHECK( tinystl::string("Content") < name );
+
+	CHECK( icase_string("apple") < icase_string("BANANA") );
+	CHECK( !(icase_string("BANANA") < icase_string("apple")) );
+	CHECK( !(icase_string("Apple") < icase_string("aPPLE")) );
+	CHECK( icase_string("app") < "APPLE" );
+	CHECK( "APP" < icase_string("apple") );
+	CHECK( icase_string("Zebra") < string_view("zebras") );
+	CHECK( !(string_view("ZEBRA") < icase_string("zebra")) );
+
+	static_assert(tinystl::icompare("abc", "ABD") < 0, "icompare is usable in constant expressions");
+	static_assert(tinystl::icompare("ABC", "abc") == 0, "icompare ignores ascii case");
+	static_assert(tinystl::icompare("abcd", "ABC") > 0, "a longer text with the same prefix orders last");
+}
@@ -0,0 +1,95 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_view.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+TEST(string_find_char) {
+	using tinystl::string;
+
+	char text[100];
+	for(size_t ii = 0; ii < sizeof(text); ++ii)
+		text[ii] = (char)('a' + ii % 7);
+	text[0] = 'x';
+	text[50] = 'x';
+	text[99] = 'x';
+
+	const string s(text, sizeof(text));
+	CHECK( s.find('x') == 0 );
+	CHECK( s.find('x', 1) == 50 );
+	CHECK( s.find('x', 51) == 99 );
+	CHECK( s.find('x', 100) == string::npos );
+	CHECK( s.find('z') == string::npos );
+
+	CHECK( s.rfind('x') == 99 );
+	CHECK( s.rfind('x', 98) == 50 );
+	CHECK( s.rfind('x', 49) == 0 );
+	CHECK( s.rfind('x', 0) == 0 );
+	CHECK( s.rfind('z') == string::npos );
+	CHECK( string().rfind('x') == string::npos );
+	CHECK( string().find('x') == string::npos );
+}
+
+TEST(string_compare_kernels) {
+	using tinystl::string;
+
+	char text[80];
+	for(size_t ii = 0; ii < sizeof(text); ++ii)
+		text[ii] = (char)('0' + ii % 10);
+
+	const string a(text, sizeof(text));
+	for(size_t ii = 0; ii < sizeof(text); ++ii) {
+		string b = a;
+		b[ii] = 'z';
+		CHECK( !(a == b) );
+		CHECK( a.compare(b) < 0 );
+		CHECK( b.compare(a) > 0 );
+	}
+
+	CHECK( a == string(text, sizeof(text)) );
+	CHECK( a.compare(string(text, sizeof(text))) == 0 );
+	CHECK( a.compare(string(text, sizeof(text) - 1)) > 0 );
+	CHECK( string(text, 40).compare(a) < 0 );
+}
+
+TEST(string_length_kernel) {
+	char text[100];
+	memset(text, 'a', sizeof(text));
+
+	for(size_t start = 0; start < 40; ++start) {
+		for(size_t len = 0; len < 50; len += 7) {
+			text[start + len] = 0;
+			CHECK( tinystl::string(text + start).size() == len );
+			CHECK( tinystl::string_view(text + start).size() == len );
+			text[start + len] = 'a';
+		}
+	}
+
+	constexpr tinystl::string_view literal("constant");
+	static_assert(literal.size() == 8, "string_view length must be usable in constant expressions");
+}
@@ -0,0 +1,169 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_format.h>
+#include <TINYSTL/string_parse.h>
+#include <TINYSTL/string_split.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+TEST(parse_integers) {
+	using tinystl::from_chars;
+	using tinystl::string_view;
+
+	long long ll = 0;
+	CHECK( from_chars("0", ll).error == tinystl::from_chars_ok && ll == 0 );
+	CHECK( from_chars("-42", ll).error == tinystl::from_chars_ok && ll == -42 );
+	CHECK( from_chars("9223372036854775807", ll).error == tinystl::from_chars_ok && ll == 9223372036854775807ll );
+	CHECK( from_chars("-9223372036854775808", ll).error == tinystl::from_chars_ok && ll == -9223372036854775807ll - 1 );
+	CHECK( from_chars("00000000000000000000000000000000012", ll).error == tinystl::from_chars_ok && ll == 12 );
+
+	// crosses the eight digit chunks
+	CHECK( from_chars("1234567890123456", ll).error == tinystl::from_chars_ok && ll == 1234567890123456ll );
+	CHECK( from_chars("12345678x", ll).error == tinystl::from_chars_ok && ll == 12345678 );
+
+	unsigned long long ull = 0;
+	CHECK( from_chars("18446744073709551615", ull).error == tinystl::from_chars_ok && ull == 18446744073709551615ull );
+	CHECK( from_chars("ff", ull, 16).error == tinystl::from_chars_ok && ull == 255 );
+	CHECK( from_chars("Zz", ull, 36).error == tinystl::from_chars_ok && ull == 35 * 36 + 35 );
+	CHECK( from_chars("101", ull, 2).error == tinystl::from_chars_ok && ull == 5 );
+
+	int i = 7;
+	CHECK( from_chars("-2147483648", i).error == tinystl::from_chars_ok && i == -2147483647 - 1 );
+	unsigned u = 0;
+	CHECK( from_chars("4294967295", u).error == tinystl::from_chars_ok && u == 4294967295u );
+}
+
+TEST(parse_integer_errors) {
+	using tinystl::from_chars;
+	using tinystl::from_chars_result;
+
+	const char* text = "99999999999999999999,";
+	long long ll = 5;
+	from_chars_result r = from_chars(text, text + strlen(text), ll);
+	CHECK( r.error == tinystl::from_chars_out_of_range );
+	CHECK( r.ptr == text + 20 );
+	CHECK( ll == 5 );
+
+	unsigned long long ull = 5;
+	CHECK( from_chars("18446744073709551616", ull).error == tinystl::from_chars_out_of_range );
+	CHECK( from_chars("-1", ull).error == tinystl::from_chars_invalid );
+
+	int i = 5;
+	CHECK( from_chars("2147483648", i).error == tinystl::from_chars_out_of_range );
+	CHECK( from_chars("-2147483649", i).error == tinystl::from_chars_out_of_range );
+	CHECK( i == 5 );
+
+	text = " 1";
+	r = from_chars(text, text + 2, i);
+	CHECK( r.error == tinystl::from_chars_invalid );
+	CHECK( r.ptr == text );
+	CHECK( from_chars("+1", i).error == tinystl::from_chars_invalid );
+	CHECK( from_chars("-", i).error == tinystl::from_chars_invalid );
+	CHECK( from_chars(tinystl::string_view(), i).error == tinystl::from_chars_invalid );
+}
+
+TEST(parse_doubles) {
+	using tinystl::from_chars;
+
+	double d = 0;
+	CHECK( from_chars("0.1", d).error == tinystl::from_chars_ok && d == 0.1 );
+	CHECK( from_chars("-1.5e3", d).error == tinystl::from_chars_ok && d == -1500.0 );
+	CHECK( from_chars(".5", d).error == tinystl::from_chars_ok && d == 0.5 );
+	CHECK( from_chars("1.", d).error == tinystl::from_chars_ok && d == 1.0 );
+	CHECK( from_chars("1e23", d).error == tinystl::from_chars_ok && d == 1e23 );
+	CHECK( from_chars("9007199254740993", d).error == tinystl::from_chars_ok && d == 9007199254740992.0 );
+	CHECK( from_chars("1.7976931348623157e308", d).error == tinystl::from_chars_ok && d == 1.7976931348623157e308 );
+	CHECK( from_chars("2.2250738585072011e-308", d).error == tinystl::from_chars_ok && d == 2.2250738585072011e-308 );
+	CHECK( from_chars("4.9406564584124654e-324", d).error == tinystl::from_chars_ok && d == 4.9406564584124654e-324 );
+
+	// just above and just below half of the smallest subnormal
+	CHECK( from_chars("2.4703282292062328e-324", d).error == tinystl::from_chars_ok && d == 4.9406564584124654e-324 );
+	CHECK( from_chars("2.4703282292062327e-324", d).error == tinystl::from_chars_out_of_range );
+
+	// exactly halfway between 1 and the next double rounds to even, any later non-zero digit rounds up
+	CHECK( from_chars("1.00000000000000011102230246251565404236316680908203125", d).error == tinystl::from_chars_ok && d == 1.0 );
+	CHECK( from_chars("1.000000000000000111022302462515654042363166809082031250000000000000000000001", d).error == tinystl::from_chars_ok && d == 1.0000000000000002 );
+
+	d = 0;
+	CHECK( from_chars("-0", d).error == tinystl::from_chars_ok && d == 0 && 1 / d < 0 );
+	CHECK( from_chars("inf", d).error == tinystl::from_chars_ok && d > 1.7976931348623157e308 );
+	CHECK( from_chars("-Infinity", d).error == tinystl::from_chars_ok && d < -1.7976931348623157e308 );
+	CHECK( from_chars("nan(0x1)", d).error == tinystl::from_chars_ok && d != d );
+
+	d = 5;
+	CHECK( from_chars("1e400", d).error == tinystl::from_chars_out_of_range && d == 5 );
+	CHECK( from_chars("e5", d).error == tinystl::from_chars_invalid );
+	CHECK( from_chars(".", d).error == tinystl::from_chars_invalid );
+
+	// an incomplete exponent is not part of the number
+	const char* text = "2.5e+x";
+	tinystl::from_chars_result r = from_chars(text, text + 6, d);
+	CHECK( r.error == tinystl::from_chars_ok && d == 2.5 );
+	CHECK( r.ptr == text + 3 );
+}
+
+TEST(parse_doubles_roundtrip) {
+	unsigned long long state = 88172645463325252ull;
+	for(int ii = 0; ii < 20000; ++ii) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		double value;
+		memcpy(&value, &state, sizeof(value));
+		if(value != value || value - value != 0)
+			continue;
+
+		tinystl::string text;
+		append_double(text, value);
+
+		double parsed;
+		const tinystl::from_chars_result r = tinystl::from_chars(text, parsed);
+		CHECK( r.error == tinystl::from_chars_ok );
+		CHECK( r.ptr == text.data() + text.size() );
+		CHECK( memcmp(&parsed, &value, sizeof(value)) == 0 );
+	}
+}
+
+TEST(parse_fields) {
+	const char* line = "17,-3.25,oops,1e2";
+
+	int count = 0;
+	double sum = 0;
+	for(tinystl::string_view field : tinystl::split(line, ",")) {
+		double value;
+		const tinystl::from_chars_result r = tinystl::from_chars(field, value);
+		if(r.error == tinystl::from_chars_ok && r.ptr == field.data() + field.size()) {
+			sum += value;
+			++count;
+		}
+	}
+
+	CHECK( count == 3 );
+	CHECK( sum == 113.75 );
+}
@@ -0,0 +1,113 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string_pool.h>
+#include <TINYSTL/unordered_map.h>
+#include <UnitTest++.h>
+
+#include <stdio.h>
+#include <string.h>
+
+TEST(string_pool_intern) {
+	tinystl::string_pool pool;
+	CHECK( pool.empty() );
+
+	const tinystl::string_atom a = pool.intern("alpha");
+	const tinystl::string_atom b = pool.intern("beta");
+	const tinystl::string_atom empty = pool.intern("");
+	CHECK( a != b && a != empty && b != empty );
+	CHECK( a.id != 0 && b.id != 0 && empty.id != 0 );
+	CHECK( pool.size() == 3 );
+
+	char alpha[] = "alpha";
+	CHECK( pool.intern(alpha) == a );
+	CHECK( pool.intern(tinystl::string_view("betamax", 4)) == b );
+	CHECK( pool.size() == 3 );
+
+	CHECK( pool.view(a) == "alpha" );
+	CHECK( pool.view(empty).empty() );
+	CHECK( 0 == strcmp(pool.c_str(b), "beta") );
+
+	CHECK( pool.lookup("beta") == b );
+	CHECK( pool.lookup("gamma").id == 0 );
+	CHECK( pool.size() == 3 );
+
+	const tinystl::string_atom none = { 0 };
+	CHECK( pool.view(none).empty() );
+	CHECK( 0 == strcmp(pool.c_str(none), "") );
+
+	pool.clear();
+	CHECK( pool.empty() );
+	CHECK( pool.lookup("alpha").id == 0 );
+	CHECK( pool.intern("beta").id == 1 );
+}
+
+TEST(string_pool_stable) {
+	tinystl::string_pool pool;
+	const tinystl::string_atom first = pool.intern("first");
+	const char* first_str = pool.c_str(first);
+
+	char long_str[100000];
+	memset(long_str, 'x', sizeof(long_str));
+	const tinystl::string_atom big = pool.intern(tinystl::string_view(long_str, sizeof(long_str)));
+
+	tinystl::string_atom atoms[20000];
+	char name[32];
+	for(int ii = 0; ii < 20000; ++ii) {
+		sprintf(name, "identifier_%d", ii);
+		atoms[ii] = pool.intern(name);
+	}
+
+	CHECK( pool.size() == 20002 );
+	CHECK( pool.c_str(first) == first_str );
+	CHECK( pool.view(big).size() == sizeof(long_str) );
+	CHECK( pool.view(big)[sizeof(long_str) - 1] == 'x' );
+
+	for(int ii = 0; ii < 20000; ++ii) {
+		sprintf(name, "identifier_%d", ii);
+		CHECK( pool.lookup(name) == atoms[ii] );
+		CHECK( 0 == strcmp(pool.c_str(atoms[ii]), name) );
+	}
+
+	tinystl::string_pool moved(static_cast<tinystl::string_pool&&>(pool));
+	CHECK( pool.empty() );
+	CHECK( moved.c_str(first) == first_str );
+	CHECK( moved.lookup("identifier_7") == atoms[7] );
+}
+
+TEST(string_pool_atom_keys) {
+	tinystl::string_pool pool;
+	tinystl::unordered_map<tinystl::string_atom, int> counts;
+
+	const char* words[] = { "a", "b", "a", "c", "a", "b" };
+	for(int ii = 0; ii < 6; ++ii)
+		counts[pool.intern(words[ii])] += 1;
+
+	CHECK( counts.size() == 3 );
+	CHECK( counts[pool.lookup("a")] == 3 );
+	CHECK( counts[pool.lookup("b")] == 2 );
+	CHECK( counts[pool.lookup("c")] == 1 );
+}
@@ -0,0 +1,92 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string_split.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+typedef tinystl::vector<tinystl::string_view> tokens;
+
+static tokens collect(const tinystl::string_split& range) {
+	tokens result;
+	for(tinystl::string_view token : range)
+		result.push_back(token);
+	return result;
+}
+
+TEST(split_fields) {
+	using tinystl::string_view;
+
+	const tokens t = collect(tinystl::split("a,b;;c,", ",;"));
+	CHECK( t.size() == 5 );
+	CHECK( t[0] == "a" );
+	CHECK( t[1] == "b" );
+	CHECK( t[2] == "" );
+	CHECK( t[3] == "c" );
+	CHECK( t[4] == "" );
+
+	CHECK( collect(tinystl::split("", ",")).empty() );
+	CHECK( collect(tinystl::split("no delimiter", ",")).size() == 1 );
+
+	// long enough to cross several blocks
+	const char* text = "0123456789 0123456789 0123456789 0123456789 0123456789 0123456789 x";
+	const tokens words = collect(tinystl::split(text, " "));
+	CHECK( words.size() == 7 );
+	CHECK( words[5] == "0123456789" );
+	CHECK( words[6] == "x" );
+	CHECK( words[6].data() == text + 66 );
+}
+
+TEST(split_lines) {
+	const tokens t = collect(tinystl::split_lines("first\r\nsecond\n\nlast"));
+	CHECK( t.size() == 4 );
+	CHECK( t[0] == "first" );
+	CHECK( t[1] == "second" );
+	CHECK( t[2] == "" );
+	CHECK( t[3] == "last" );
+
+	const tokens trailing = collect(tinystl::split_lines("one\ntwo\n"));
+	CHECK( trailing.size() == 2 );
+	CHECK( trailing[1] == "two" );
+}
+
+TEST(split_csv) {
+	const tokens t = collect(tinystl::split_csv("id,\"Smith, John\",\"say \"\"hi\"\"\",,end"));
+	CHECK( t.size() == 5 );
+	CHECK( t[0] == "id" );
+	CHECK( t[1] == "\"Smith, John\"" );
+	CHECK( t[2] == "\"say \"\"hi\"\"\"" );
+	CHECK( t[3] == "" );
+	CHECK( t[4] == "end" );
+
+	const tokens tabs = collect(tinystl::split_csv("a\t\"b\tc\"", "\t"));
+	CHECK( tabs.size() == 2 );
+	CHECK( tabs[1] == "\"b\tc\"" );
+
+	const tokens unterminated = collect(tinystl::split_csv("a,\"b,c"));
+	CHECK( unterminated.size() == 2 );
+	CHECK( unterminated[1] == "\"b,c" );
+}
@@ -0,0 +1,196 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+
+#include "counting_allocator.h"
+
+TEST(string_sso_layout) {
+	typedef tinystl::basic_string<counting_allocator> string;
+
+	CHECK( sizeof(string) == 3 * sizeof(void*) );
+
+	const size_t inline_capacity = sizeof(string) - 1;
+	const char* text = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+	const size_t allocations = counting_allocator::allocations;
+	{
+		string s(text, inline_capacity);
+		CHECK( s.size() == inline_capacity );
+		CHECK( s.capacity() == inline_capacity );
+		CHECK( s.c_str()[inline_capacity] == 0 );
+		CHECK( 0 == strncmp(s.c_str(), text, inline_capacity) );
+		CHECK( (const void*)s.c_str() >= (const void*)&s && (const void*)s.c_str() < (const void*)(&s + 1) );
+
+		s.pop_back();
+		s.push_back('!');
+		CHECK( s.size() == inline_capacity );
+		CHECK( s.back() == '!' );
+	}
+	CHECK( counting_allocator::allocations == allocations );
+
+	{
+		string s(text, inline_capacity);
+		s.push_back('!');
+		CHECK( counting_allocator::allocations == allocations + 1 );
+		CHECK( s.size() == inline_capacity + 1 );
+		CHECK( s.capacity() > inline_capacity );
+		CHECK( 0 == strncmp(s.c_str(), text, inline_capacity) );
+		CHECK( s.c_str()[inline_capacity] == '!' );
+		CHECK( s.c_str()[inline_capacity + 1] == 0 );
+
+		s.resize(3);
+		s.shrink_to_fit();
+		CHECK( s.size() == 3 );
+		CHECK( s.capacity() == inline_capacity );
+		CHECK( 0 == strcmp(s.c_str(), "abc") );
+	}
+}
+
+TEST(string_sso_move_swap) {
+	using tinystl::string;
+
+	{
+		string small("small");
+		string large("a string long enough to live on the heap");
+		const char* large_data = large.c_str();
+
+		small.swap(large);
+		CHECK( 0 == strcmp(large.c_str(), "small") );
+		CHECK( small.c_str() == large_data );
+
+		string moved = std::move(small);
+		CHECK( moved.c_str() == large_data );
+		CHECK( small.size() == 0 );
+		CHECK( 0 == strcmp(small.c_str(), "") );
+	}
+	{
+		string s("tiny");
+		string moved = std::move(s);
+		CHECK( 0 == strcmp(moved.c_str(), "tiny") );
+		CHECK( s.empty() );
+	}
+}
+
+TEST(string_sso_move_no_allocation) {
+	typedef tinystl::basic_string<counting_allocator> string;
+
+	const size_t allocations = counting_allocator::allocations;
+	const size_t deallocations = counting_allocator::deallocations;
+	{
+		tinystl::vector<string> v;
+		v.reserve(64);
+		char text[64];
+		for(int ii = 0; ii < 64; ++ii) {
+			// alternate inline and heap strings
+			const int len = sprintf(text, ii % 2 ? "%d" : "a string long enough for the heap %d", ii);
+			v.push_back(string(text, (size_t)len));
+		}
+		const size_t loaded = counting_allocator::allocations;
+		CHECK( loaded == allocations + 32 );
+
+		// reverse with swaps, then rotate with move construction and assignment
+		for(size_t ii = 0, jj = v.size() - 1; ii < jj; ++ii, --jj)
+			v[ii].swap(v[jj]);
+		string first = std::move(v[0]);
+		for(size_t ii = 1; ii < v.size(); ++ii)
+			v[ii - 1] = std::move(v[ii]);
+		v.back() = std::move(first);
+		CHECK( first.empty() );
+
+		// moving a heap string over another heap string frees only the old one
+		const size_t freed = counting_allocator::deallocations;
+		v[0] = std::move(v[2]);
+		CHECK( counting_allocator::deallocations == freed + 1 );
+		CHECK( v[2].empty() );
+
+		string& self = v[5];
+		v[5] = std::move(self);
+		CHECK( v[5].size() == 2 );
+
+		CHECK( counting_allocator::allocations == loaded );
+		CHECK( 0 == strcmp(v[0].c_str(), "a string long enough for the heap 60") );
+		CHECK( 0 == strcmp(v[1].c_str(), "61") );
+		CHECK( 0 == strcmp(v[3].c_str(), "59") );
+		CHECK( 0 == strcmp(v[62].c_str(), "a string long enough for the heap 0") );
+		CHECK( 0 == strcmp(v[63].c_str(), "63") );
+	}
+	CHECK( counting_allocator::allocations - allocations == counting_allocator::deallocations - deallocations );
+}
+
+TEST(string_sso_splice) {
+	using tinystl::string;
+
+	{
+		string s("hello");
+		s.insert((size_t)0, '>');
+		s.insert(s.end(), '<');
+		CHECK( 0 == strcmp(s.c_str(), ">hello<") );
+
+		s.insert(1, s);
+		CHECK( 0 == strcmp(s.c_str(), ">>hello<hello<") );
+
+		s.append(s.begin() + 2, s.begin() + 7);
+		CHECK( 0 == strcmp(s.c_str(), ">>hello<hello<hello") );
+
+		s.erase(0, 2);
+		CHECK( 0 == strcmp(s.c_str(), "hello<hello<hello") );
+
+		s.assign(s.begin() + 6, s.end());
+		CHECK( 0 == strcmp(s.c_str(), "hello<hello") );
+	}
+	{
+		string s(4, 'x');
+		CHECK( 0 == strcmp(s.c_str(), "xxxx") );
+
+		s.resize(40, 'y');
+		CHECK( s.size() == 40 );
+		CHECK( s[3] == 'x' && s[4] == 'y' && s[39] == 'y' );
+		CHECK( s.c_str()[40] == 0 );
+	}
+}
+
+TEST(string_sso_erase_past_end) {
+	using tinystl::string;
+
+	string s("hello world");
+	s.erase(6, 100);
+	CHECK( s.size() == 6 );
+	CHECK( 0 == strcmp(s.c_str(), "hello ") );
+
+	string h("a string that already lives on the heap");
+	h.erase(8, 1000);
+	CHECK( 0 == strcmp(h.c_str(), "a string") );
+	h.erase(8);
+	CHECK( h.size() == 8 );
+	h.erase(0, string::npos);
+	CHECK( h.empty() );
+}
@@ -0,0 +1,89 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_split.h>
+#include <UnitTest++.h>
+
+#include "counting_allocator.h"
+
+namespace {
+	size_t count_vowels(tinystl::string_view v) {
+		size_t count = 0;
+		for(size_t pos = v.find_first_of("aeiou"); pos != tinystl::string_view::npos; pos = v.find_first_of("aeiou", pos + 1))
+			++count;
+		return count;
+	}
+}
+
+TEST(string_substr_view) {
+	typedef tinystl::basic_string<counting_allocator> string;
+
+	const string s("Content-Type: application/json; charset=utf-8");
+	const size_t allocations = counting_allocator::allocations;
+
+	const tinystl::string_view name = s.substr_view(0, s.find(':'));
+	CHECK( name == "Content-Type" );
+	CHECK( name.data() == s.data() );
+
+	const tinystl::string_view value = s.substr_view(s.find(':') + 2);
+	CHECK( value == "application/json; charset=utf-8" );
+	CHECK( s.substr_view(s.size()).empty() );
+	CHECK( s.substr_view(40, 100) == "utf-8" );
+
+	CHECK( s.view().size() == s.size() );
+	CHECK( s.view().data() == s.c_str() );
+	CHECK( counting_allocator::allocations == allocations );
+}
+
+TEST(string_implicit_view) {
+	using tinystl::string;
+
+	const string s("the quick brown fox");
+	const tinystl::string_view v = s;
+	CHECK( v.size() == s.size() );
+	CHECK( count_vowels(s) == 5 );
+
+	size_t words = 0;
+	for(tinystl::string_view word : tinystl::split(s, " ")) {
+		CHECK( !word.empty() );
+		++words;
+	}
+	CHECK( words == 4 );
+
+	CHECK( s.find(v.substr(4, 5)) == 4 );
+	CHECK( s.find("brown") == 10 );
+	CHECK( s.rfind(tinystl::string_view("o")) == 17 );
+
+	string t(v.substr(4, 5));
+	t += s.substr_view(9, 6);
+	t.append(tinystl::string_view(" fox"));
+	t.insert((size_t)0, tinystl::string_view(">"));
+	CHECK( t == ">quick brown fox" );
+
+	t.append(t.view());
+	CHECK( t == ">quick brown fox>quick brown fox" );
+}
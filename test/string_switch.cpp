@@ -0,0 +1,77 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_switch.h>
+#include <TINYSTL/string_view.h>
+#include <UnitTest++.h>
+
+namespace {
+	enum opcode { op_unknown, op_push, op_pop, op_add, op_jump_if_zero };
+
+	constexpr opcode parse_opcode(tinystl::string_view text) {
+		using tinystl::string_case;
+
+		const tinystl::string_switch op(text);
+		switch(op) {
+		case string_case("push"): return op.is("push") ? op_push : op_unknown;
+		case string_case("pop"): return op.is("pop") ? op_pop : op_unknown;
+		case string_case("add"): return op.is("add") ? op_add : op_unknown;
+		case string_case("jump_if_zero"): return op.is("jump_if_zero") ? op_jump_if_zero : op_unknown;
+		default: return op_unknown;
+		}
+	}
+}
+
+TEST(string_hash_constexpr) {
+	constexpr size_t abc = tinystl::hash_string("abc", 3);
+	static_assert(abc == tinystl::hash(tinystl::string_view("abc")), "hash of string_view matches hash_string");
+	static_assert(tinystl::string_case("abc") == abc, "case labels hash like string_view");
+	static_assert(tinystl::hash_string("", 0) == 0, "empty string hashes to zero");
+
+	// the compile time hash matches the runtime hash of every string type
+	const tinystl::string s("abc");
+	CHECK( hash(s) == abc );
+	CHECK( tinystl::hash_string(s.c_str(), s.size()) == abc );
+}
+
+TEST(string_switch_dispatch) {
+	static_assert(parse_opcode("pop") == op_pop, "dispatch is usable at compile time");
+
+	CHECK( parse_opcode("push") == op_push );
+	CHECK( parse_opcode("pop") == op_pop );
+	CHECK( parse_opcode("add") == op_add );
+	CHECK( parse_opcode("jump_if_zero") == op_jump_if_zero );
+
+	CHECK( parse_opcode("") == op_unknown );
+	CHECK( parse_opcode("pus") == op_unknown );
+	CHECK( parse_opcode("pushh") == op_unknown );
+	CHECK( parse_opcode("jump_if_zerO") == op_unknown );
+
+	const tinystl::string text("add");
+	CHECK( parse_opcode(text) == op_add );
+	CHECK( tinystl::string_switch(text).view() == "add" );
+}
@@ -0,0 +1,101 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string_table.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+
+#include <stdio.h>
+
+#include "counting_allocator.h"
+
+TEST(string_table_add) {
+	CHECK( sizeof(tinystl::string_handle) == 8 );
+
+	tinystl::string_table table;
+	CHECK( table.empty() );
+
+	const tinystl::string_handle a = table.add("apple");
+	const tinystl::string_handle empty = table.add("");
+	const tinystl::string_handle b = table.add("banana");
+	CHECK( table.bytes() == 11 );
+	CHECK( table.view(a) == "apple" );
+	CHECK( table.view(empty).empty() );
+	CHECK( table[b] == "banana" );
+	CHECK( a != b );
+
+	tinystl::vector<tinystl::string_handle> handles;
+	char word[32];
+	for(int ii = 0; ii < 10000; ++ii) {
+		const int len = sprintf(word, "word%d", ii);
+		handles.push_back(table.add(tinystl::string_view(word, (size_t)len)));
+	}
+
+	// handles survive every reallocation of the characters
+	CHECK( table.view(a) == "apple" );
+	for(int ii = 0; ii < 10000; ++ii) {
+		const int len = sprintf(word, "word%d", ii);
+		CHECK( table[handles[ii]] == tinystl::string_view(word, (size_t)len) );
+	}
+
+	// adding characters of the table itself refers to them in place
+	const size_t bytes = table.bytes();
+	const tinystl::string_handle nan = table.add(table[b].substr(2, 3));
+	CHECK( table.bytes() == bytes );
+	CHECK( table[nan] == "nan" );
+
+	tinystl::string_table copy(table);
+	table.clear();
+	CHECK( table.empty() );
+	CHECK( copy[b] == "banana" );
+	CHECK( copy[handles[9999]] == "word9999" );
+
+	table = static_cast<tinystl::string_table&&>(copy);
+	CHECK( table[handles[42]] == "word42" );
+}
+
+TEST(string_table_bulk_load) {
+	const char* words[] = { "alpha", "beta", "gamma", "delta", "epsilon" };
+
+	size_t total = 0;
+	for(int ii = 0; ii < 5; ++ii)
+		total += tinystl::string_view(words[ii]).size();
+
+	const size_t allocations = counting_allocator::allocations;
+	{
+		tinystl::basic_string_table<counting_allocator> table;
+		table.reserve(total);
+
+		tinystl::string_handle handles[5];
+		for(int ii = 0; ii < 5; ++ii)
+			handles[ii] = table.add(words[ii]);
+
+		CHECK( counting_allocator::allocations == allocations + 1 );
+		CHECK( table.bytes() == total );
+		CHECK( table[handles[4]] == "epsilon" );
+		CHECK( table.data()[0] == 'a' );
+	}
+}
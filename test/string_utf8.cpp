@@ -0,0 +1,128 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string.h>
+#include <TINYSTL/string_utf8.h>
+#include <TINYSTL/vector.h>
+#include <UnitTest++.h>
+#include <string.h>
+
+static bool valid(const char* s) {
+	return tinystl::utf8_validate(tinystl::string_view(s, strlen(s)));
+}
+
+TEST(utf8_validate_sequences) {
+	CHECK( valid("") );
+	CHECK( valid("plain ascii") );
+	CHECK( valid("\xc3\xa9") );
+	CHECK( valid("\xe2\x82\xac") );
+	CHECK( valid("\xf0\x9f\x98\x80") );
+	CHECK( valid("\xed\x9f\xbf") );
+	CHECK( valid("\xf4\x8f\xbf\xbf") );
+
+	// stray continuation, overlong forms, surrogates, past U+10FFFF
+	CHECK( !valid("\x80") );
+	CHECK( !valid("\xc0\x80") );
+	CHECK( !valid("\xc1\xbf") );
+	CHECK( !valid("\xe0\x9f\xbf") );
+	CHECK( !valid("\xf0\x8f\xbf\xbf") );
+	CHECK( !valid("\xed\xa0\x80") );
+	CHECK( !valid("\xf4\x90\x80\x80") );
+	CHECK( !valid("\xf5\x80\x80\x80") );
+	CHECK( !valid("\xff") );
+
+	// truncated sequences and extra continuation bytes
+	CHECK( !valid("\xe2\x82") );
+	CHECK( !valid("\xf0\x9f\x98") );
+	CHECK( !valid("\xc3\xa9\xa9") );
+	CHECK( !valid("\xe2\x82 ") );
+}
+
+TEST(utf8_validate_blocks) {
+	// an error or a truncated sequence at every offset of a long text
+	char text[100];
+	for(size_t ii = 0; ii < sizeof(text); ++ii)
+		text[ii] = (char)('a' + ii % 26);
+
+	for(size_t len = 1; len <= sizeof(text); ++len) {
+		CHECK( tinystl::utf8_validate(tinystl::string_view(text, len)) );
+
+		for(size_t pos = 0; pos + 1 < len; ++pos) {
+			text[pos] = '\xc3';
+			text[pos + 1] = '\xa9';
+			CHECK( tinystl::utf8_validate(tinystl::string_view(text, len)) );
+			text[pos + 1] = 'x';
+			CHECK( !tinystl::utf8_validate(tinystl::string_view(text, len)) );
+			text[pos] = (char)('a' + pos % 26);
+			text[pos + 1] = (char)('a' + (pos + 1) % 26);
+		}
+
+		text[len - 1] = '\xe2';
+		CHECK( !tinystl::utf8_validate(tinystl::string_view(text, len)) );
+		text[len - 1] = (char)('a' + (len - 1) % 26);
+	}
+}
+
+TEST(utf8_to_utf16) {
+	tinystl::vector<char16_t> out;
+	CHECK( tinystl::utf8_to_utf16("a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80", out) );
+	CHECK( out.size() == 5 );
+	CHECK( out[0] == u'a' );
+	CHECK( out[1] == 0xe9 );
+	CHECK( out[2] == 0x20ac );
+	CHECK( out[3] == 0xd83d );
+	CHECK( out[4] == 0xde00 );
+
+	// appends, and leaves the output alone on invalid input
+	CHECK( !tinystl::utf8_to_utf16("ok \xed\xa0\x80", out) );
+	CHECK( out.size() == 5 );
+	CHECK( tinystl::utf8_to_utf16("0123456789abcdefghijklmnopqrstuvwxyz", out) );
+	CHECK( out.size() == 41 );
+	CHECK( out[5] == u'0' );
+	CHECK( out[40] == u'z' );
+}
+
+TEST(utf16_to_utf8) {
+	const char16_t text[] = u"0123456789 \u00e9\u20ac\U0001F600 abcdefghij";
+	const size_t len = sizeof(text) / sizeof(text[0]) - 1;
+
+	tinystl::string out;
+	CHECK( tinystl::utf16_to_utf8(text, text + len, out) );
+	CHECK( out == "0123456789 \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80 abcdefghij" );
+
+	tinystl::vector<char16_t> back;
+	CHECK( tinystl::utf8_to_utf16(out, back) );
+	CHECK( back.size() == len );
+	CHECK( memcmp(back.begin(), text, len * sizeof(char16_t)) == 0 );
+
+	// unpaired surrogates
+	const char16_t high[] = { u'a', 0xd83d, u'b' };
+	const char16_t low[] = { 0xde00 };
+	CHECK( !tinystl::utf16_to_utf8(high, high + 3, out) );
+	CHECK( !tinystl::utf16_to_utf8(high, high + 2, out) );
+	CHECK( !tinystl::utf16_to_utf8(low, low + 1, out) );
+	CHECK( out == "0123456789 \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80 abcdefghij" );
+}
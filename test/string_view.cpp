@@ -0,0 +1,111 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/string_view.h>
+#include <TINYSTL/unordered_set.h>
+#include <UnitTest++.h>
+
+static_assert(tinystl::string_view("key=value").find('=') == 3, "constexpr find");
+static_assert(tinystl::string_view("key=value").find("val") == 4, "constexpr substring find");
+static_assert(tinystl::string_view("a.b.c").rfind('.') == 3, "constexpr rfind");
+static_assert(tinystl::string_view("a, b; c").find_first_of(",;") == 1, "constexpr find_first_of");
+static_assert(tinystl::string_view("a, b; c").find_last_of(",;") == 4, "constexpr find_last_of");
+static_assert(tinystl::string_view("abc") < tinystl::string_view("abd"), "constexpr ordering");
+static_assert(tinystl::string_view("abc") == tinystl::string_view("abc"), "constexpr equality");
+static_assert(tinystl::string_view("prefix.suffix").starts_with("prefix"), "constexpr starts_with");
+static_assert(tinystl::string_view("prefix.suffix").ends_with(".suffix"), "constexpr ends_with");
+
+TEST(string_view_search) {
+	using tinystl::string_view;
+
+	const string_view v("GET /api/v1/items?id=42&sort=name HTTP/1.1");
+	CHECK( v.find("/api") == 4 );
+	CHECK( v.find('?') == 17 );
+	CHECK( v.find('?', 18) == string_view::npos );
+	CHECK( v.rfind('/') == 38 );
+	CHECK( v.rfind('/', 37) == 11 );
+	CHECK( v.rfind("HTTP") == 34 );
+	CHECK( v.find_first_of("?&=") == 17 );
+	CHECK( v.find_first_of("?&=", 18) == 20 );
+	CHECK( v.find_last_of("?&=") == 28 );
+	CHECK( v.find_last_of("?&=", 27) == 23 );
+	CHECK( v.find_first_of("#!") == string_view::npos );
+	CHECK( v.find_first_of("") == string_view::npos );
+	CHECK( v.find_last_of('G') == 0 );
+	CHECK( v.find_first_of("abcdefghijklmnopqrstuvwxyz") == 5 );
+	CHECK( v.find_last_of("abcdefghijklmnopqrstuvwxyz") == 32 );
+	CHECK( v.contains("sort") );
+	CHECK( !v.contains('#') );
+
+	CHECK( string_view().find('a') == string_view::npos );
+	CHECK( string_view().rfind('a') == string_view::npos );
+	CHECK( string_view().find("") == 0 );
+	CHECK( string_view().find_last_of("a") == string_view::npos );
+}
+
+TEST(string_view_compare) {
+	using tinystl::string_view;
+
+	const string_view a("alpha");
+	const string_view b("beta");
+	CHECK( a.compare(b) < 0 );
+	CHECK( b.compare(a) > 0 );
+	CHECK( a.compare("alpha") == 0 );
+	CHECK( a.compare("alphabet") < 0 );
+	CHECK( a < b && a <= b && b > a && b >= a );
+	CHECK( a != b );
+	CHECK( a == "alpha" );
+	CHECK( "alpha" == a );
+
+	CHECK( a.starts_with('a') && a.ends_with('a') );
+	CHECK( !string_view().starts_with('a') );
+	CHECK( a.starts_with("") && a.ends_with("") );
+	CHECK( !a.ends_with("alphas") );
+}
+
+TEST(string_view_trim) {
+	using tinystl::string_view;
+
+	string_view v("  padded  ");
+	v.remove_prefix(v.find_first_of("p"));
+	v.remove_suffix(v.size() - 1 - v.find_last_of("d"));
+	CHECK( v == "padded" );
+	CHECK( v.front() == 'p' && v.back() == 'd' );
+}
+
+TEST(string_view_hash) {
+	using tinystl::string_view;
+
+	const char text[] = "one two one";
+	CHECK( hash(string_view(text, 3)) == hash(string_view(text + 8, 3)) );
+
+	tinystl::unordered_set<string_view> words;
+	words.insert(string_view(text, 3));
+	words.insert(string_view(text + 4, 3));
+	words.insert(string_view(text + 8, 3));
+	CHECK( words.size() == 2 );
+	CHECK( words.find("two") != words.end() );
+}
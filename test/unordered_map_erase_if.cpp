@@ -0,0 +1,78 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/unordered_set.h>
+#include <UnitTest++.h>
+
+TEST(uomap_erase_if) {
+	typedef tinystl::unordered_map<int, int> unordered_map;
+	using tinystl::make_pair;
+
+	unordered_map m;
+	for (int ii = 0; ii != 100; ++ii)
+		m.insert(make_pair(ii, ii * 2));
+
+	CHECK( 50 == erase_if(m, [](const tinystl::unordered_hash_node<int, int>& node) { return node.first % 2 == 1; }) );
+	CHECK( m.size() == 50 );
+	for (int ii = 0; ii != 100; ++ii)
+		CHECK( (m.find(ii) != m.end()) == (ii % 2 == 0) );
+
+	size_t count = 0;
+	for (unordered_map::iterator it = m.begin(), end = m.end(); it != end; ++it)
+		++count;
+	CHECK( count == 50 );
+
+	// buckets stay consistent for further inserts and erases
+	for (int ii = 1; ii < 100; ii += 2)
+		m.insert(make_pair(ii, ii * 2));
+	CHECK( m.size() == 100 );
+	m.erase(42);
+	CHECK( m.find(42) == m.end() );
+	CHECK( m[43] == 86 );
+
+	CHECK( 99 == m.erase_if([](const tinystl::unordered_hash_node<int, int>&) { return true; }) );
+	CHECK( m.empty() );
+	CHECK( m.begin() == m.end() );
+}
+
+TEST(uoset_erase_if) {
+	typedef tinystl::unordered_set<int> unordered_set;
+
+	unordered_set s;
+	for (int ii = 0; ii != 40; ++ii)
+		s.insert(ii);
+
+	CHECK( 30 == erase_if(s, [](int key) { return key >= 10; }) );
+	CHECK( s.size() == 10 );
+	for (int ii = 0; ii != 40; ++ii)
+		CHECK( (s.find(ii) != s.end()) == (ii < 10) );
+
+	CHECK( 0 == s.erase_if([](int key) { return key >= 10; }) );
+	s.insert(25);
+	CHECK( s.find(25) != s.end() );
+	CHECK( s.size() == 11 );
+}
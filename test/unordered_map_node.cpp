@@ -0,0 +1,141 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/unordered_map.h>
+#include <TINYSTL/unordered_set.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+#include <utility>
+
+#include "counting_allocator.h"
+
+TEST(uomap_extract) {
+	typedef tinystl::unordered_map<int, int> unordered_map;
+	using tinystl::make_pair;
+
+	unordered_map m;
+	for (int ii = 0; ii != 20; ++ii)
+		m.insert(make_pair(ii, 10*ii));
+
+	{
+		unordered_map::node_type node = m.extract(5);
+		CHECK( !node.empty() );
+		CHECK( node.key() == 5 );
+		CHECK( node.mapped() == 50 );
+		CHECK( m.size() == 19 );
+		CHECK( m.find(5) == m.end() );
+
+		node.mapped() = 55;
+		tinystl::pair<unordered_map::iterator, bool> p = m.insert(std::move(node));
+		CHECK( p.second );
+		CHECK( node.empty() );
+		CHECK( p.first->first == 5 );
+		CHECK( m.size() == 20 );
+		CHECK( m[5] == 55 );
+	}
+
+	{
+		unordered_map::node_type node = m.extract(100);
+		CHECK( node.empty() );
+
+		tinystl::pair<unordered_map::iterator, bool> p = m.insert(std::move(node));
+		CHECK( !p.second );
+		CHECK( p.first == m.end() );
+	}
+
+	{
+		unordered_map::node_type node = m.extract(m.find(7));
+		CHECK( node.key() == 7 );
+
+		m.insert(make_pair(7, 0));
+		tinystl::pair<unordered_map::iterator, bool> p = m.insert(std::move(node));
+		CHECK( !p.second );
+		CHECK( !node.empty() );
+		CHECK( p.first->second == 0 );
+	}
+
+	size_t count = 0;
+	for (unordered_map::iterator it = m.begin(), end = m.end(); it != end; ++it)
+		++count;
+	CHECK( count == m.size() );
+}
+
+TEST(uomap_merge) {
+	typedef tinystl::unordered_map<tinystl::string, int, counting_allocator> unordered_map;
+	using tinystl::make_pair;
+	using tinystl::string;
+
+	unordered_map a, b;
+	a.insert(make_pair(string("one"), 1));
+	a.insert(make_pair(string("two"), 2));
+	for (int ii = 0; ii != 50; ++ii) {
+		char name[] = { 'k', char('0' + ii / 10), char('0' + ii % 10), 0 };
+		b.insert(make_pair(string(name), ii));
+	}
+	b.insert(make_pair(string("two"), 20));
+
+	a.merge(b);
+	CHECK( a.size() == 52 );
+	CHECK( b.size() == 1 );
+	CHECK( a["two"] == 2 );
+	CHECK( b.find("two") != b.end() );
+	CHECK( a["k42"] == 42 );
+
+	b.clear();
+	const size_t allocations = counting_allocator::allocations;
+	b.merge(a);
+	CHECK( b.size() == 52 );
+	CHECK( a.empty() );
+	CHECK( b["k07"] == 7 );
+	CHECK( counting_allocator::allocations - allocations < 4 );
+}
+
+TEST(uoset_extract_merge) {
+	typedef tinystl::unordered_set<int> unordered_set;
+
+	unordered_set a, b;
+	for (int ii = 0; ii != 10; ++ii) {
+		a.insert(ii);
+		b.insert(ii + 5);
+	}
+
+	unordered_set::node_type node = a.extract(3);
+	CHECK( node.value() == 3 );
+	CHECK( a.size() == 9 );
+	CHECK( a.find(3) == a.end() );
+
+	CHECK( b.insert(std::move(node)).second );
+	CHECK( node.empty() );
+	CHECK( b.size() == 11 );
+
+	a.merge(b);
+	CHECK( a.size() == 15 );
+	CHECK( b.size() == 5 );
+	for (int ii = 0; ii != 15; ++ii)
+		CHECK( a.find(ii) != a.end() );
+	for (int ii = 5; ii != 10; ++ii)
+		CHECK( b.find(ii) != b.end() );
+}
@@ -29,6 +29,8 @@
 #include <UnitTest++.h>
 #include <utility>
 
+#include "counting_allocator.h"
+
 template<typename T>
 static void comparesets(const tinystl::unordered_set<T>& s, const tinystl::unordered_set<T>& expected) {
 	CHECK( s.size() == expected.size() );
@@ -170,3 +172,27 @@ TEST(uoset_insert) {
 		CHECK( key.size() == 0 );
 	}
 }
+
+TEST(uoset_default_no_allocation) {
+	typedef tinystl::unordered_set<int, counting_allocator> unordered_set;
+
+	const size_t allocations = counting_allocator::allocations;
+	{
+		unordered_set s;
+		CHECK( s.empty() );
+		CHECK( s.begin() == s.end() );
+		CHECK( s.find(3) == s.end() );
+		CHECK( s.erase(3) == 0 );
+		s.clear();
+
+		unordered_set copy = s;
+		unordered_set moved = std::move(copy);
+		CHECK( moved.empty() );
+	}
+	CHECK( counting_allocator::allocations == allocations );
+
+	unordered_set s;
+	CHECK( s.insert(3).second );
+	CHECK( s.find(3) != s.end() );
+	CHECK( counting_allocator::allocations != allocations );
+}
@@ -0,0 +1,93 @@
+/*-
+ * Copyright 2012-2018 Matthew Endsley
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted providing that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TINYSTL/vector.h>
+#include <TINYSTL/string.h>
+#include <UnitTest++.h>
+
+namespace {
+	struct is_odd {
+		bool operator()(int value) const { return (value & 1) != 0; }
+	};
+}
+
+TEST(vector_erase_if) {
+	typedef tinystl::vector<int> vector;
+
+	{
+		vector v;
+		for (int ii = 0; ii != 10; ++ii)
+			v.push_back(ii);
+
+		CHECK( 5 == erase_if(v, is_odd()) );
+		CHECK( v.size() == 5 );
+		for (size_t ii = 0; ii != v.size(); ++ii)
+			CHECK( v[ii] == 2 * (int)ii );
+
+		CHECK( 0 == erase_if(v, is_odd()) );
+		CHECK( v.size() == 5 );
+	}
+
+	{
+		vector v;
+		CHECK( 0 == v.erase_if(is_odd()) );
+		CHECK( v.empty() );
+	}
+
+	{
+		tinystl::vector<tinystl::string> v;
+		v.push_back("keep one");
+		v.push_back("drop one, long enough to be on the heap");
+		v.push_back("keep two, long enough to be on the heap");
+		v.push_back("drop two");
+
+		CHECK( 2 == v.erase_if([](const tinystl::string& s) { return s[0] == 'd'; }) );
+		CHECK( v.size() == 2 );
+		CHECK( v[0] == "keep one" );
+		CHECK( v[1] == "keep two, long enough to be on the heap" );
+	}
+}
+
+TEST(vector_erase_if_unordered) {
+	typedef tinystl::vector<int> vector;
+
+	vector v;
+	for (int ii = 0; ii != 10; ++ii)
+		v.push_back(ii);
+
+	CHECK( 5 == erase_if_unordered(v, is_odd()) );
+	CHECK( v.size() == 5 );
+
+	int sum = 0;
+	for (vector::iterator it = v.begin(), end = v.end(); it != end; ++it) {
+		CHECK( !is_odd()(*it) );
+		sum += *it;
+	}
+	CHECK( sum == 0 + 2 + 4 + 6 + 8 );
+
+	CHECK( 5 == v.erase_if_unordered([](int) { return true; }) );
+	CHECK( v.empty() );
+}